@@ -1,6 +1,7 @@
 import argparse as ap
 import ctypes as ct
 import os
+import struct
 import time
 import typing as tp
 import warnings
@@ -40,11 +41,15 @@ class Config(tp.NamedTuple):
         lower (int): minimal `nian`, `sui` and year
         upper (int): maximal `nian`, `sui` and year
         output (str): path to output HPP data file
+        binary (str): path to output binary data file, or empty
+        era (int): `nian`s per segment in binary, or 0 for one
     '''
 
     lower: int
     upper: int
     output: str
+    binary: str
+    era: int
 
 
 def load_config() -> Config:
@@ -67,11 +72,27 @@ def load_config() -> Config:
         'help': 'path to output HPP data file',
         'metavar': 'PATH',
     }
+    kw_bin: dict[str, tp.Any] = {
+        'type': str,
+        'default': '',
+        'help': 'path to output binary data file, mapped at runtime',
+        'metavar': 'PATH',
+    }
+    kw_era: dict[str, tp.Any] = {
+        'type': int,
+        'default': 0,
+        'help': 'nians per segment fitted on its own in binary',
+        'metavar': 'NIANS',
+    }
     parser.add_argument('-l', '--lower', **kw_min)
     parser.add_argument('-u', '--upper', **kw_max)
     parser.add_argument('-o', '--output', **kw_out)
+    parser.add_argument('-b', '--binary', **kw_bin)
+    parser.add_argument('-e', '--era', **kw_era)
     args: ap.Namespace = parser.parse_args()
-    return Config(args.lower, args.upper, args.output)
+    return Config(
+        args.lower, args.upper, args.output, args.binary, args.era,
+    )
 
 
 class Format:
@@ -149,7 +170,7 @@ def trim_data(data: Data, conf: Config) -> Data:
     Removes lunar and solar data out of bounds.
     '''
 
-    (lu, so), (lo, hi, _) = data, conf
+    (lu, so), (lo, hi, *_) = data, conf
     # lunar: `nian` and `cyue`
     lu_fi: pd.Series = lu['nian'].between(lo, hi)
     # aligns `nian` to whole line
@@ -493,6 +514,8 @@ def js_bytes(ress: list[int]) -> list[int]:
         list[int]: bytes converted from JS residuals
     '''
 
+    if any(not 0 <= res < (1 << Format.JS_BIT) for res in ress):
+        raise ValueError('bad idea, residuals out of range')
     colls: list[int] = []
     for trib in vals_to_colls(ress, bit=12, ipc=2):
         lo: int = trib & 0xff
@@ -564,6 +587,24 @@ def sj_fit(so: pd.DataFrame) -> CoefsLv2:
 ICX: tp.LiteralString = 'inline constexpr'
 
 
+def data_limits(conf: Config, data: Data) -> tuple[int, int, int, int]:
+    '''
+    Gets bounds of `cyue` and `cjie` within bounds of `nian`.
+
+    Returns:
+        tuple[int, int, int, int]: min and max `cyue`, `cjie`
+    '''
+
+    (lo, hi, *_), (lu, so) = conf, data
+    lf: pd.Series = lu['nian'].between(lo, hi) # lunar filter
+    ym: int = int(lu[lf]['cyue'].min()) # cyue min
+    yM: int = int(lu[lf]['cyue'].max()) # cyue max
+    sf: pd.Series = so['sui'].between(lo, hi) # solar filter
+    jm: int = int(so[sf]['cjie'].min()) # cjie min
+    jM: int = int(so[sf]['cjie'].max()) # cjie max
+    return ym, yM, jm, jM
+
+
 def write_head(hpp: str, conf: Config, data: Data) -> int:
     '''
     Writes head and time bounds into HPP file.
@@ -576,13 +617,8 @@ def write_head(hpp: str, conf: Config, data: Data) -> int:
         int: total bytes of variables into C++
     '''
 
-    (lo, hi, _), (lu, so) = conf, data
-    lf: pd.Series = lu['nian'].between(lo, hi) # lunar filter
-    ym: int = int(lu[lf]['cyue'].min()) # cyue min
-    yM: int = int(lu[lf]['cyue'].max()) # cyue max
-    sf: pd.Series = so['sui'].between(lo, hi) # solar filter
-    jm: int = int(so[sf]['cjie'].min()) # cjie min
-    jM: int = int(so[sf]['cjie'].max()) # cjie max
+    lo, hi, *_ = conf
+    ym, yM, jm, jM = data_limits(conf, data)
     with open(hpp, 'a') as hpp_out:
         hpp_out.write('#ifndef IW_DATA_HPP\n')
         hpp_out.write('#define IW_DATA_HPP 20251005L\n\n')
@@ -931,31 +967,209 @@ def write_sj_coef(hpp: str, coefs: CoefsLv2) -> int:
     return 8 * len(coefs)
 
 
+## Section 3.3. Binary: all in one file, mapped by `mapped.hpp`
+
+
+class Tables(tp.NamedTuple):
+    '''
+    Fittings and residual bytes, as exported into HPP.
+    '''
+
+    nr_bt: list[int]
+    ny_cf: CoefsLv1
+    ny_bt: list[int]
+    yd_cf: CoefsLv1
+    yd_bt: list[int]
+    dy_cf: CoefsExact
+    yn_cf: CoefsExact
+    js_cf: CoefsSolar
+    js_bt: list[int]
+    sj_cf: CoefsLv2
+
+
+def pack_layout(
+    conf: Config, data: Data, tabs: Tables, refs: list[int], size: int,
+) -> bytes:
+    '''
+    Packs bounds, coefficients and table references of version 1.
+
+    Layout (little-endian, see `iw17::mapped::layout`):
+        * magic `IWNONGLI`, version, header and file bytes
+        * bounds of `nian`, `sui`, year (i16), `cyue`, `cjie` (i32)
+        * bits and coefficients of NY, YD, DY, YN, JS, SJ (i64)
+        * offsets and bytes of NR, NY, YD, JS tables (u64)
+
+    Returns:
+        bytes: 1664 bytes of head
+    '''
+
+    lo, hi, *_ = conf
+    ym, yM, jm, jM = data_limits(conf, data)
+    *ny, ny_nb = tabs.ny_cf
+    *yd, yd_nb = tabs.yd_cf
+    *dy, dy_nb = tabs.dy_cf
+    *yn, yn_nb = tabs.yn_cf
+    k0, b0, js_nb, cs = tabs.js_cf
+    *sj, sj_nb = tabs.sj_cf
+    i64s: list[int] = [
+        ny_nb, *ny, yd_nb, *yd, dy_nb, *dy, yn_nb, *yn,
+        js_nb, k0, b0, *np.asarray(cs).reshape(-1).tolist(),
+        sj_nb, *sj,
+    ]
+    head: bytes = struct.pack(
+        f'<8sIIQ6h4ii{len(i64s)}q8Q',
+        b'IWNONGLI', 1, 1664, size,
+        lo, hi, lo, hi, lo, hi, ym, yM, jm, jM, 0,
+        *map(int, i64s), *refs,
+    )
+    assert len(head) == 1664, 'layout of version 1'
+    return head
+
+
+def put_tables(body: bytearray, tabs: Tables) -> list[int]:
+    '''
+    Appends tables, each aligned to 64 bytes, pages joined.
+
+    Returns:
+        list[int]: offsets and bytes of NR, NY, YD, JS tables
+    '''
+
+    tables: list[bytes] = [
+        bytes(tabs.nr_bt), bytes(tabs.ny_bt),
+        bytes(tabs.yd_bt), bytes(tabs.js_bt),
+    ]
+    refs: list[int] = []
+    for tab in tables:
+        body.extend(bytes(-len(body) % 64))
+        refs.extend([len(body), len(tab)])
+        body.extend(tab)
+    return refs
+
+
+def write_bin(path: str, conf: Config, data: Data, tabs: Tables) -> int:
+    '''
+    Writes all tables into one binary file, version 1: the head of
+    `pack_layout` at offset 0, then tables of `put_tables`.
+
+    Returns:
+        int: total bytes of the file
+    '''
+
+    body: bytearray = bytearray(1664)
+    refs: list[int] = put_tables(body, tabs)
+    body[:1664] = pack_layout(conf, data, tabs, refs, len(body))
+    with open(path, 'wb') as bin_out:
+        bin_out.write(body)
+    return len(body)
+
+
+class Era(tp.NamedTuple):
+    '''
+    A segment fitted on its own, with bounds in `conf`.
+    '''
+
+    conf: Config
+    data: Data
+    tabs: Tables
+
+
+def era_keys(era: Era, end: bool = False) -> tuple[int, ...]:
+    '''
+    Gets the first `nian`, `cyue`, `cjie`, uday and usec of `era`,
+    or of the next one if `end`, as in `iw17::mapped::segment`.
+    '''
+
+    (lo, hi, *_), (lu, so) = era.conf, era.data
+    ym, yM, jm, jM = data_limits(era.conf, era.data)
+    if end:
+        lo, ym, jm = hi + 1, yM + 1, jM + 1
+    uday: int = int(lu[lu['cyue'] == ym]['uday'].iloc[0])
+    usec: int = int(so[so['cjie'] == jm]['usec'].iloc[0])
+    return lo, ym, jm, uday, usec
+
+
+def write_eras(path: str, eras: list[Era]) -> int:
+    '''
+    Writes consecutive eras into one binary file, version 2.
+
+    Layout (little-endian, see `iw17::mapped::directory`):
+        * magic `IWNONGLI`, version, header and file bytes, segments
+        * first keys and offset of each segment, then those of ends
+        * each segment: head of `pack_layout`, then its tables
+
+    Returns:
+        int: total bytes of the file
+    '''
+
+    nseg: int = len(eras)
+    body: bytearray = bytearray(32 * (nseg + 2))
+    heads: list[tuple[int, list[int]]] = []
+    for era in eras:
+        body.extend(bytes(-len(body) % 64))
+        at: int = len(body)
+        body.extend(bytes(1664))
+        heads.append((at, put_tables(body, era.tabs)))
+    for era, (at, refs) in zip(eras, heads):
+        head = pack_layout(era.conf, era.data, era.tabs, refs, len(body))
+        body[at:at + 1664] = head
+    body[:32] = struct.pack(
+        '<8sIIQIi', b'IWNONGLI', 2, 32, len(body), nseg, 0,
+    )
+    for i, (era, (at, _)) in enumerate(zip(eras, heads)):
+        entry: bytes = struct.pack('<4iqQ', *era_keys(era), at)
+        body[32 * (i + 1):32 * (i + 2)] = entry
+    ends: tuple[int, ...] = era_keys(eras[-1], end=True)
+    body[32 * (nseg + 1):32 * (nseg + 2)] = struct.pack('<4iqQ', *ends, 0)
+    with open(path, 'wb') as bin_out:
+        bin_out.write(body)
+    return len(body)
+
+
 # Part 4: Export
 
 
-def main() -> None:
-    t0: float = time.perf_counter()
-    conf: Config = load_config()
-    here: str = os.path.dirname(__file__)
-    csv_dir: str = os.path.join(here, 'build')
-    data: Data = load_data(csv_dir)
-    # makes `js_fit` well-conditioned
+def fit_tables(data: Data, conf: Config, cond: bool) -> Era:
+    '''
+    Fits all tables within bounds of `conf`, on `data` untrimmed.
+
+    Args:
+        cond (bool): fits `cjie_to_usec` over bounds including 0
+    '''
+
     js_so: pd.DataFrame = data.solar
-    if conf.lower > 0:
+    lo, hi, *_ = conf
+    if cond and conf.lower > 0:
         lo, hi = 0, conf.upper
-    elif conf.upper < 0:
+    elif cond and conf.upper < 0:
         lo, hi = conf.lower, 0
-    else:
-        lo, hi = conf[:2]
     js_so = js_so[js_so['sui'].between(lo, hi + 1)]
     js_cf, js_rs = js_fit(js_so)
-    lo, hi, hpp = conf
+    lo, hi, *_ = conf
     js_fi: pd.Series = js_so['sui'].between(lo, hi)
     js_ra: Int64s = np.array(js_rs)[js_fi]
     js_rs = tp.cast(list[int], js_ra.tolist())
     data = trim_data(data, conf)
     lunar, solar = data
+    nr_bt: list[int] = nr_bytes(nr_runs(lunar))
+    ny_cf, ny_ry = ny_fit(lunar)
+    yd_cf, yd_rd = yd_fit(lunar)
+    tabs: Tables = Tables(
+        nr_bt, ny_cf, ny_bytes(ny_ry), yd_cf, yd_bytes(yd_rd),
+        dy_fit(lunar), yn_fit(lunar), js_cf, js_bytes(js_rs),
+        sj_fit(solar),
+    )
+    return Era(conf, data, tabs)
+
+
+def main() -> None:
+    t0: float = time.perf_counter()
+    conf: Config = load_config()
+    here: str = os.path.dirname(__file__)
+    csv_dir: str = os.path.join(here, 'build')
+    full: Data = load_data(csv_dir)
+    # makes `js_fit` well-conditioned
+    _, data, tabs = fit_tables(full, conf, cond=True)
+    lo, hi, hpp, bin_path, era = conf
     # head
     if not hpp:
         hpp = here
@@ -966,39 +1180,45 @@ def main() -> None:
     total: int = 0
     total += write_head(hpp, conf, data)
     # `nian_to_run`
-    nr_rs: list[int] = nr_runs(lunar)
-    nr_bt: list[int] = nr_bytes(nr_rs)
-    total += write_nr(hpp, runs=nr_bt)
+    total += write_nr(hpp, runs=tabs.nr_bt)
     # `nian_to_cyue`
-    ny_cf, ny_ry = ny_fit(lunar)
-    total += write_ny_coef(hpp, coefs=ny_cf)
-    ny_bt: list[int] = ny_bytes(ny_ry)
-    total += write_ny_resy(hpp, resy=ny_bt)
+    total += write_ny_coef(hpp, coefs=tabs.ny_cf)
+    total += write_ny_resy(hpp, resy=tabs.ny_bt)
     # `cyue_to_uday`
-    yd_cf, yd_rd = yd_fit(lunar)
-    total += write_yd_coef(hpp, coefs=yd_cf)
-    yd_bt: list[int] = yd_bytes(yd_rd)
-    total += write_yd_resd(hpp, resd=yd_bt)
+    total += write_yd_coef(hpp, coefs=tabs.yd_cf)
+    total += write_yd_resd(hpp, resd=tabs.yd_bt)
     # `uday_to_cyue`
-    dy_cf: CoefsExact = dy_fit(lunar)
-    total += write_dy_coef(hpp, coefs=dy_cf)
+    total += write_dy_coef(hpp, coefs=tabs.dy_cf)
     # `cyue_to_nian`
-    yn_cf: CoefsExact = yn_fit(lunar)
-    total += write_yn_coef(hpp, coefs=yn_cf)
+    total += write_yn_coef(hpp, coefs=tabs.yn_cf)
     # `shihou_to_usec`
-    total += write_js_coef(hpp, coefs=js_cf)
-    js_bt: list[int] = js_bytes(js_rs)
-    total += write_js_ress(hpp, ress=js_bt)
+    total += write_js_coef(hpp, coefs=tabs.js_cf)
+    total += write_js_ress(hpp, ress=tabs.js_bt)
     # `usec_to_shihou`
-    sj_cf: CoefsLv2 = sj_fit(solar)
-    total += write_sj_coef(hpp, coefs=sj_cf)
+    total += write_sj_coef(hpp, coefs=tabs.sj_cf)
     # tail
     t1: float = time.perf_counter()
     secs: float = t1 - t0
     write_tail(hpp, total)
     hpp = os.path.abspath(hpp)
     print(f'data exported to \"{hpp}\", {secs:.3f} s taken')
+    # binary
+    if bin_path and era > 0:
+        # coefficients per era, each looked up in constant time,
+        # conditioned as the main table
+        eras: list[Era] = [
+            fit_tables(full, conf._replace(
+                lower=lo_e, upper=min(lo_e + era - 1, hi),
+            ), cond=True)
+            for lo_e in range(lo, hi + 1, era)
+        ]
+        size: int = write_eras(bin_path, eras)
+    elif bin_path:
+        size = write_bin(bin_path, conf, data, tabs)
+    if bin_path:
+        bin_path = os.path.abspath(bin_path)
+        print(f'data exported to \"{bin_path}\", {size} bytes')
 
 
 if __name__ == '__main__':
-    main()
\ No newline at end of file
+    main()
@@ -0,0 +1,172 @@
+'''
+Dumps ground truth from split CSVs into a compact binary fixture.
+Note: Run `split.py` first, so that `build/*.csv` are there.
+'''
+
+import argparse as ap
+import csv
+import os
+import struct
+import typing as tp
+
+
+class Config(tp.NamedTuple):
+    '''
+    Configurations for the fixture to dump.
+
+    Attributes:
+        lower (int): minimal `nian`, `sui` and year
+        upper (int): maximal `nian`, `sui` and year
+        out (str): path of the fixture
+    '''
+
+    lower: int
+    upper: int
+    out: str
+
+
+def load_config() -> Config:
+    here: str = os.path.dirname(__file__)
+    out: str = os.path.join(here, '..', 'fit', 'test', 'truth.bin')
+    parser: ap.ArgumentParser = ap.ArgumentParser()
+    kw_min: dict[str, tp.Any] = {
+        'type': int,
+        'default': 1900,
+        'help': 'lower bound of nian, sui, year',
+        'metavar': 'MIN',
+    }
+    kw_max: dict[str, tp.Any] = {
+        'type': int,
+        'default': 2199,
+        'help': 'upper bound of nian, sui, year',
+        'metavar': 'MAX',
+    }
+    kw_out: dict[str, tp.Any] = {
+        'type': str,
+        'default': out,
+        'help': 'path of the binary fixture',
+        'metavar': 'PATH',
+    }
+    parser.add_argument('-l', '--lower', **kw_min)
+    parser.add_argument('-u', '--upper', **kw_max)
+    parser.add_argument('-o', '--out', **kw_out)
+    args: ap.Namespace = parser.parse_args()
+    return Config(args.lower, args.upper, args.out)
+
+
+class Format:
+    '''
+    Layout of the fixture, all little-endian.
+
+    Attributes:
+        MAGIC (bytes): leading 4 bytes of the file
+        VERSION (int): version of the layout
+        HEAD (str): magic, version, `nian`s, `cyue`s, `cjie`s, reserved
+        YUE (str): first uday, `nian` and `ryue` of each `cyue`
+        JIE (str): usec of each `cjie`
+    '''
+
+    MAGIC: bytes = b'IWTR'
+    VERSION: int = 1
+    HEAD: str = '<4sIhhiIiII'
+    YUE: str = '<ihbx'
+    JIE: str = '<q'
+
+
+def usec_to_uday(usec: int) -> int:
+    '''
+    Converts unix seconds to the uday of its date in UTC+8.
+
+    Examples:
+        >>> usec_to_uday(-28800)
+        0
+        >>> usec_to_uday(-28801)
+        -1
+    '''
+
+    return (usec + 28800) // 86400
+
+
+def load_rows(path: str) -> list[dict[str, int]]:
+    '''
+    Loads a CSV of `split.py` as rows of integers.
+
+    Args:
+        path (str): path of `lunar.csv` or `solar.csv`
+    Returns:
+        list[dict[str, int]]: rows keyed by the header
+    '''
+
+    with open(path, 'r', newline='') as in_fp:
+        reader: csv.DictReader = csv.DictReader(in_fp)
+        return [{k: int(v) for k, v in row.items()} for row in reader]
+
+
+def pack_lunar(rows: list[dict[str, int]], lo: int, hi: int) -> bytes:
+    '''
+    Packs `cyue`s of `nian`s in [lo, hi], and the one after.
+
+    Args:
+        rows (list[dict[str, int]]): rows of `lunar.csv`
+        lo (int): minimal `nian`
+        hi (int): maximal `nian`
+    Returns:
+        bytes: records of consecutive `cyue`s
+    '''
+
+    rows = sorted(rows, key=lambda r: r['cyue'])
+    keep: list[dict[str, int]] = [r for r in rows if lo <= r['nian'] <= hi]
+    nxt: list[dict[str, int]] = [r for r in rows if r['nian'] == hi + 1]
+    keep.append(nxt[0])
+    body: bytearray = bytearray()
+    for old, new in zip(keep[:-1], keep[1:]):
+        if new['cyue'] != old['cyue'] + 1:
+            raise ValueError(f'cyue {old["cyue"] + 1} missing')
+    for row in keep:
+        uday: int = usec_to_uday(row['usec'])
+        body += struct.pack(Format.YUE, uday, row['nian'], row['ryue'])
+    return bytes(body)
+
+
+def pack_solar(rows: list[dict[str, int]], lo: int, hi: int) -> bytes:
+    '''
+    Packs `cjie`s of `sui`s in [lo, hi].
+
+    Args:
+        rows (list[dict[str, int]]): rows of `solar.csv`
+        lo (int): minimal `sui`
+        hi (int): maximal `sui`
+    Returns:
+        bytes: records of consecutive `cjie`s
+    '''
+
+    rows = sorted(rows, key=lambda r: r['cjie'])
+    keep: list[dict[str, int]] = [r for r in rows if lo <= r['sui'] <= hi]
+    if len(keep) != 24 * (hi - lo + 1):
+        raise ValueError(f'sui {lo} to {hi} incomplete')
+    return b''.join(struct.pack(Format.JIE, r['usec']) for r in keep)
+
+
+def main() -> None:
+    conf: Config = load_config()
+    lo, hi, out = conf
+    here: str = os.path.dirname(__file__)
+    csv_dir: str = os.path.join(here, 'build')
+    lu: list[dict[str, int]] = load_rows(os.path.join(csv_dir, 'lunar.csv'))
+    so: list[dict[str, int]] = load_rows(os.path.join(csv_dir, 'solar.csv'))
+    body_lu: bytes = pack_lunar(lu, lo, hi)
+    body_so: bytes = pack_solar(so, lo, hi)
+    cyue_min: int = min(r['cyue'] for r in lu if r['nian'] == lo)
+    cyues: int = len(body_lu) // struct.calcsize(Format.YUE)
+    cjies: int = len(body_so) // struct.calcsize(Format.JIE)
+    head: bytes = struct.pack(Format.HEAD, Format.MAGIC, Format.VERSION,
+        lo, hi, cyue_min, cyues, 24 * (lo - 1970), cjies, 0)
+    with open(out, 'wb') as out_fp:
+        out_fp.write(head + body_lu + body_so)
+    out = os.path.abspath(out)
+    size: int = len(head) + len(body_lu) + len(body_so)
+    print(f'truth exported to "{out}", {size} bytes')
+
+
+if __name__ == '__main__':
+    main()
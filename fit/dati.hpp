@@ -1,5 +1,5 @@
 #ifndef IW_DATI_HPP
-#define IW_DATI_HPP 20250206L
+#define IW_DATI_HPP 20251016L
 
 #include "math.hpp"
 
@@ -11,21 +11,28 @@ struct date {
     int8_t day;
 };
 
-constexpr bool check_date(date locd) noexcept {
-    auto [y, m, d] = locd;
-    if (m < 1 || m > 12 || d < 1 || d > 31) {
-        return false;
-    }
+// for `mon` in [1, 12]
+constexpr int8_t days_in_month(int16_t year, int8_t mon) noexcept {
     constexpr int8_t DAYS_IN_MONTH[] = {
         31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31,
     };
-    if (m == 2) {
-        bool leap = (!(y & 3) && y % 25) || !(y & 15);
-        return d <= DAYS_IN_MONTH[m - 1] + leap;
+    if (mon == 2) {
+        bool leap = (!(year & 3) && year % 25) || !(year & 15);
+        return 28 + leap;
+    }
+    return DAYS_IN_MONTH[mon - 1];
+}
+
+constexpr bool check_date(date locd) noexcept {
+    auto [y, m, d] = locd;
+    if (m < 1 || m > 12 || d < 1) {
+        return false;
     }
-    return d <= DAYS_IN_MONTH[m - 1];
+    return d <= days_in_month(y, m);
 }
 
+namespace _ref { // divmod cascade, reference of the affine ones
+
 constexpr int32_t date_to_uday(date locd) noexcept {
     auto [y, m, d] = locd;
     if ((m -= 3) < 0) {
@@ -63,6 +70,51 @@ constexpr date uday_to_date(int32_t uday) noexcept {
     return date{int16_t(y + ym5q), m, d};
 }
 
+} // namespace _ref
+
+namespace _eaf { // Euclidean affine functions, after Neri-Schneider
+
+// all `int16_t` years counted from a March 1st of a positive year
+constexpr uint32_t ERAS = 82; // 400-year cycles shifted
+constexpr uint32_t YEAR_SHIFT = 400 * ERAS;
+constexpr uint32_t UDAY_SHIFT = 719468 + 146097 * ERAS;
+
+// upper 32 bits of `a * b`
+constexpr uint32_t mulhi(uint32_t a, uint32_t b) noexcept {
+    return uint32_t(uint64_t(a) * b >> 32);
+}
+
+} // namespace _eaf
+
+// branchless, by multiplications and shifts only
+constexpr int32_t date_to_uday(date locd) noexcept {
+    using namespace _eaf;
+    uint32_t y = uint32_t(locd.year + int32_t(YEAR_SHIFT));
+    uint32_t m = uint32_t(locd.mon), d = uint32_t(locd.day);
+    uint32_t jf = m < 3; // as months 13 and 14 of the year before
+    uint32_t ym = y - jf, mm = m + 12 * jf;
+    uint32_t c = mulhi(ym, 42949673); // `ym / 100`
+    uint32_t dy = (1461 * ym >> 2) - c + (c >> 2);
+    uint32_t dm = (979 * mm - 2919) >> 5;
+    return int32_t(dy + dm + d - 1) - int32_t(UDAY_SHIFT);
+}
+
+// branchless, by multiplications and shifts only
+constexpr date uday_to_date(int32_t uday) noexcept {
+    using namespace _eaf;
+    uint32_t n1 = 4 * uint32_t(uday + int32_t(UDAY_SHIFT)) + 3;
+    uint32_t c = mulhi(n1, 3853261556) >> 17; // `n1 / 146097`
+    uint32_t n2 = (n1 - 146097 * c) | 3;
+    uint32_t z = mulhi(n2, 2939745); // `n2 / 1461`
+    uint32_t ny = (n2 - 1461 * z) >> 2; // days since March 1st
+    uint32_t n3 = 2141 * ny + 197913;
+    uint32_t jf = ny >= 306; // January or February
+    uint32_t y = 100 * c + z + jf - YEAR_SHIFT;
+    uint32_t m = (n3 >> 16) - 12 * jf;
+    uint32_t d = ((n3 & 0xffff) * 62690 >> 27) + 1; // `/ 2141`
+    return date{int16_t(y), int8_t(m), int8_t(d)};
+}
+
 enum class tzinfo: int8_t {
     west_1200,  west_1145,  west_1130,  west_1115,
     west_1100,  west_1045,  west_1030,  west_1015,
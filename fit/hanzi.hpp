@@ -0,0 +1,518 @@
+#ifndef IW_HANZI_HPP
+#define IW_HANZI_HPP 20251016L
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "nongli.hpp"
+#include "range.hpp"
+
+namespace iw17::hanzi { // names in UTF-8, 3 bytes per hanzi
+
+using name_t = std::string_view;
+
+inline constexpr name_t TIANGAN[10] = {
+    "甲", "乙", "丙", "丁", "戊", "己", "庚", "辛", "壬", "癸",
+};
+
+inline constexpr name_t DIZHI[12] = {
+    "子", "丑", "寅", "卯", "辰", "巳",
+    "午", "未", "申", "酉", "戌", "亥",
+};
+
+inline constexpr name_t JIEQI[24] = {
+    "冬至", "小寒", "大寒", "立春", "雨水", "惊蛰",
+    "春分", "清明", "谷雨", "立夏", "小满", "芒种",
+    "夏至", "小暑", "大暑", "立秋", "处暑", "白露",
+    "秋分", "寒露", "霜降", "立冬", "小雪", "大雪",
+};
+
+inline constexpr name_t ZODIAC[12] = {
+    "白羊座", "金牛座", "双子座", "巨蟹座", "狮子座", "处女座",
+    "天秤座", "天蝎座", "射手座", "摩羯座", "水瓶座", "双鱼座",
+};
+
+inline constexpr name_t YUE[12] = {
+    "正月", "二月", "三月", "四月", "五月", "六月",
+    "七月", "八月", "九月", "十月", "十一月", "十二月",
+};
+
+inline constexpr name_t RUN = "闰";
+
+inline constexpr name_t DAXIAO[2] = { // of 29 and 30 days
+    "小", "大",
+};
+
+inline constexpr name_t TIAN[30] = {
+    "初一", "初二", "初三", "初四", "初五",
+    "初六", "初七", "初八", "初九", "初十",
+    "十一", "十二", "十三", "十四", "十五",
+    "十六", "十七", "十八", "十九", "二十",
+    "廿一", "廿二", "廿三", "廿四", "廿五",
+    "廿六", "廿七", "廿八", "廿九", "三十",
+};
+
+inline constexpr name_t DIGITS[10] = {
+    "〇", "一", "二", "三", "四", "五", "六", "七", "八", "九",
+};
+
+// `nian`, `yue`, `ri` and `shi` of `bazi`, and `sui`
+inline constexpr name_t UNITS[5] = {
+    "年", "月", "日", "时", "岁",
+};
+
+namespace _hz { // `ganzhi`s, `tiangan` and `dizhi` joined
+
+struct ganzhi_bytes {
+    char bytes[60][6];
+};
+
+constexpr ganzhi_bytes make_ganzhi_bytes() noexcept {
+    ganzhi_bytes out = {};
+    for (int8_t i = 0; i < 60; i++) {
+        for (int8_t k = 0; k < 3; k++) {
+            out.bytes[i][k] = TIANGAN[i % 10][k];
+            out.bytes[i][k + 3] = DIZHI[i % 12][k];
+        }
+    }
+    return out;
+}
+
+inline constexpr ganzhi_bytes GANZHI_BYTES = make_ganzhi_bytes();
+
+struct ganzhi_names {
+    name_t names[60];
+};
+
+constexpr ganzhi_names make_ganzhi_names() noexcept {
+    ganzhi_names out = {};
+    for (int8_t i = 0; i < 60; i++) {
+        out.names[i] = name_t(GANZHI_BYTES.bytes[i], 6);
+    }
+    return out;
+}
+
+inline constexpr ganzhi_names GANZHI_NAMES = make_ganzhi_names();
+
+// `name` at `str`, returning the end
+constexpr char *put(char *str, name_t name) noexcept {
+    for (char byte: name) {
+        *str++ = byte;
+    }
+    return str;
+}
+
+// decimal digits of `num` in hanzi, one by one
+constexpr char *put_digits(char *str, uint32_t num) noexcept {
+    uint32_t base = 1;
+    while (base <= num / 10) {
+        base *= 10;
+    }
+    for (; base != 0; base /= 10) {
+        str = put(str, DIGITS[num / base % 10]);
+    }
+    return str;
+}
+
+} // namespace _hz
+
+inline constexpr const name_t (&GANZHI)[60] = _hz::GANZHI_NAMES.names;
+
+constexpr name_t name(tiangan gan) noexcept {
+    return TIANGAN[int8_t(gan)];
+}
+
+constexpr name_t name(dizhi zhi) noexcept {
+    return DIZHI[int8_t(zhi)];
+}
+
+constexpr name_t name(ganzhi zhu) noexcept {
+    return GANZHI[int8_t(zhu)];
+}
+
+constexpr name_t name(jieqi jie) noexcept {
+    return JIEQI[int8_t(jie)];
+}
+
+constexpr name_t name(zodiac zod) noexcept {
+    return ZODIAC[int8_t(zod)];
+}
+
+// bytes written at most by each `format_*`
+inline constexpr uint64_t RIQI_MAX = 27; // `甲辰年闰十二月廿九`
+inline constexpr uint64_t YUE_MAX = 15; // `闰十二月大`
+inline constexpr uint64_t SHIHOU_MAX = 21; // `二〇二四岁冬至`
+inline constexpr uint64_t BAZI_MAX = 36; // `甲辰年丙寅月戊午日壬子时`
+
+// none if not `check_riqi`; returns the end of bytes written
+constexpr char *format_riqi(riqi rizi, char *str) noexcept {
+    auto [nian, ryue, tian] = rizi;
+    if (!check_riqi(rizi)) {
+        return str;
+    }
+    str = _hz::put(str, name(nian_to_ganzhi(nian)));
+    str = _hz::put(str, UNITS[0]);
+    if (ryue & 1) {
+        str = _hz::put(str, RUN);
+    }
+    str = _hz::put(str, YUE[(ryue >> 1) - 1]);
+    return _hz::put(str, TIAN[tian - 1]);
+}
+
+// `ryue` of `nian` with its days, e.g. `闰四月小`; none if no such
+// `yue`; returns the end of bytes written
+constexpr char *format_yue(
+    int16_t nian, int8_t ryue, char *str
+) noexcept {
+    if (!check_riqi({nian, ryue, 1})) {
+        return str;
+    }
+    riqi hui = riqi_to_hui({nian, ryue, 1});
+    if (ryue & 1) {
+        str = _hz::put(str, RUN);
+    }
+    str = _hz::put(str, YUE[(ryue >> 1) - 1]);
+    return _hz::put(str, DAXIAO[hui.tian == 30]);
+}
+
+// `sui` in digits; none if `sui` out of 0 to 9999 or `jie` not a
+// `jieqi`; returns the end of bytes written
+constexpr char *format_shihou(shihou shi, char *str) noexcept {
+    auto [sui, jie] = shi;
+    if (sui < 0 || sui > 9999 || int8_t(jie) < 0 || int8_t(jie) >= 24) {
+        return str;
+    }
+    str = _hz::put_digits(str, uint32_t(sui));
+    str = _hz::put(str, UNITS[4]);
+    return _hz::put(str, name(jie));
+}
+
+// none if any `zhu` not a `ganzhi`; returns the end of bytes written
+constexpr char *format_bazi(bazi zhus, char *str) noexcept {
+    for (ganzhi zhu: zhus.zhu) {
+        if (int8_t(zhu) < 0 || int8_t(zhu) >= 60) {
+            return str;
+        }
+    }
+    for (int8_t i = 0; i < 4; i++) {
+        str = _hz::put(str, name(zhus.zhu[i]));
+        str = _hz::put(str, UNITS[i]);
+    }
+    return str;
+}
+
+// of `parse_*`, `ok` or why not
+enum class status: int8_t {
+    ok,
+    unknown, // bytes not of hanzi in names
+    malformed, // hanzi out of the form of names
+    invalid, // well-formed, but out of range or not `check_riqi`
+};
+
+namespace _hz { // hanzi by code points, in perfect hashes
+
+inline constexpr uint8_t NONE = 0xff;
+
+// code point of the 3 bytes of UTF-8 at `str`, or 0 if not one
+constexpr uint32_t decode(const char *str) noexcept {
+    uint32_t b0 = uint8_t(str[0]), b1 = uint8_t(str[1]);
+    uint32_t b2 = uint8_t(str[2]);
+    if ((b0 & 0xf0) != 0xe0 || (b1 & 0xc0) != 0x80
+        || (b2 & 0xc0) != 0x80) {
+        return 0;
+    }
+    uint32_t code = (b0 & 0x0f) << 12 | (b1 & 0x3f) << 6 | (b2 & 0x3f);
+    return (code >= 0x800) ? code : 0; // not overlong
+}
+
+// distinct nonzero keys into `1 << B` slots, by a multiplier
+template <int B>
+struct phash {
+    uint32_t mult;
+    uint32_t keys[1 << B];
+    uint8_t vals[1 << B];
+
+    constexpr uint32_t slot(uint32_t key) const noexcept {
+        return (key * mult) >> (32 - B);
+    }
+
+    constexpr uint8_t find(uint32_t key) const noexcept {
+        uint32_t i = slot(key);
+        return (keys[i] == key) ? vals[i] : NONE;
+    }
+};
+
+// multipliers tried in turn until no collision; `mult` of 0 if none
+template <int B, uint64_t N>
+constexpr phash<B> make_phash(
+    const uint32_t (&keys)[N], const uint8_t (&vals)[N]
+) noexcept {
+    uint64_t seed = 0x9e3779b97f4a7c15;
+    for (int32_t t = 0; t < 100000; t++) {
+        seed = seed * 6364136223846793005 + 1442695040888963407;
+        phash<B> out = {uint32_t(seed >> 32) | 1, {}, {}};
+        bool free = true;
+        for (uint64_t i = 0; i < N && free; i++) {
+            uint32_t s = out.slot(keys[i]);
+            free = out.keys[s] == 0;
+            out.keys[s] = keys[i], out.vals[s] = vals[i];
+        }
+        if (free) {
+            return out;
+        }
+    }
+    return phash<B>{};
+}
+
+// kinds in high 4 bits of glyphs, values in low 4 bits
+inline constexpr uint8_t G_DIGIT = 0x00; // `〇` or `零` to `九`
+inline constexpr uint8_t G_GAN = 0x10;
+inline constexpr uint8_t G_ZHI = 0x20;
+inline constexpr uint8_t G_TEN = 0x30; // `十` and `廿`
+inline constexpr uint8_t G_UNIT = 0x40; // of `UNITS`
+inline constexpr uint8_t G_RUN = 0x50;
+inline constexpr uint8_t G_CHU = 0x60;
+inline constexpr uint8_t G_YUE = 0x70; // `正`, `冬` and `腊`
+
+constexpr uint8_t kind(uint8_t glyph) noexcept {
+    return glyph & 0xf0;
+}
+
+constexpr int8_t value(uint8_t glyph) noexcept {
+    return int8_t(glyph & 0x0f);
+}
+
+inline constexpr uint64_t NGLYPH = 45;
+
+struct glyph_list {
+    uint32_t keys[NGLYPH];
+    uint8_t vals[NGLYPH];
+};
+
+constexpr glyph_list make_glyph_list() noexcept {
+    glyph_list out = {};
+    uint64_t n = 0;
+    auto add = [&](name_t name, uint8_t glyph) {
+        out.keys[n] = decode(name.data()), out.vals[n++] = glyph;
+    };
+    for (uint8_t i = 0; i < 10; i++) {
+        add(TIANGAN[i], G_GAN | i), add(DIGITS[i], G_DIGIT | i);
+    }
+    for (uint8_t i = 0; i < 12; i++) {
+        add(DIZHI[i], G_ZHI | i);
+    }
+    for (uint8_t i = 0; i < 5; i++) {
+        add(UNITS[i], G_UNIT | i);
+    }
+    add("零", G_DIGIT | 0), add("十", G_TEN | 1), add("廿", G_TEN | 2);
+    add(RUN, G_RUN), add("初", G_CHU);
+    add("正", G_YUE | 1), add("冬", G_YUE | 11), add("腊", G_YUE | 12);
+    return out;
+}
+
+inline constexpr glyph_list GLYPH_LIST = make_glyph_list();
+inline constexpr phash<8> GLYPHS =
+    make_phash<8>(GLYPH_LIST.keys, GLYPH_LIST.vals);
+static_assert(GLYPHS.mult != 0, "no perfect hash of glyphs");
+
+// of the hanzi at `str`, or NONE if not one of names
+constexpr uint8_t glyph(const char *str) noexcept {
+    uint32_t code = decode(str);
+    return (code != 0) ? GLYPHS.find(code) : NONE;
+}
+
+struct jieqi_list {
+    uint32_t keys[24];
+    uint8_t vals[24];
+};
+
+// code points of both hanzi as keys
+constexpr jieqi_list make_jieqi_list() noexcept {
+    jieqi_list out = {};
+    for (uint8_t i = 0; i < 24; i++) {
+        const char *str = JIEQI[i].data();
+        out.keys[i] = decode(str) << 16 | decode(str + 3);
+        out.vals[i] = i;
+    }
+    return out;
+}
+
+inline constexpr jieqi_list JIEQI_LIST = make_jieqi_list();
+inline constexpr phash<7> JIEQIS =
+    make_phash<7>(JIEQI_LIST.keys, JIEQI_LIST.vals);
+static_assert(JIEQIS.mult != 0, "no perfect hash of jieqis");
+
+} // namespace _hz
+
+// `一九九〇年闰五月廿三`, `nian` in 4 digits, `〇` or `零` for 0, and
+// `yue` also in `冬月` and `腊月`; `rizi` unchanged if not `ok`
+constexpr status parse_riqi(name_t text, riqi &rizi) noexcept {
+    using namespace _hz;
+    constexpr uint64_t NMAX = 11; // `一九九〇年闰十一月廿三`
+    uint64_t num = text.size() / 3;
+    if (text.size() % 3 != 0) {
+        return status::unknown;
+    }
+    if (num > NMAX) {
+        return status::malformed;
+    }
+    uint8_t gs[NMAX + 1] = {}; // ending in `NONE`s
+    for (uint64_t i = 0; i <= NMAX; i++) {
+        gs[i] = (i < num) ? glyph(text.data() + 3 * i) : NONE;
+        if (i < num && gs[i] == NONE) {
+            return status::unknown;
+        }
+    }
+    uint64_t k = 0;
+    int32_t nian = 0;
+    for (; k < 4 && kind(gs[k]) == G_DIGIT; k++) {
+        nian = 10 * nian + value(gs[k]);
+    }
+    if (k != 4 || gs[k++] != (G_UNIT | 0)) {
+        return status::malformed;
+    }
+    int8_t run = (gs[k] == G_RUN) ? 1 : 0;
+    k += run;
+    // `正` or `二` to `十`, `十一`, `十二`, `冬` and `腊`
+    int8_t yue = 0;
+    if (kind(gs[k]) == G_YUE
+        || (kind(gs[k]) == G_DIGIT && value(gs[k]) >= 2)) {
+        yue = value(gs[k++]);
+    } else if (gs[k] == (G_TEN | 1)) {
+        bool more = gs[++k] == (G_DIGIT | 1) || gs[k] == (G_DIGIT | 2);
+        yue = 10 + (more ? value(gs[k++]) : 0);
+    }
+    if (yue == 0 || gs[k++] != (G_UNIT | 1)) {
+        return status::malformed;
+    }
+    // `初一` to `初十`, `十一` to `十九`, `二十`, `廿一` to `廿九`, `三十`
+    uint8_t g0 = gs[k], g1 = gs[k + 1];
+    bool ones = kind(g1) == G_DIGIT && value(g1) != 0;
+    int8_t tian = 0;
+    if ((g0 == G_CHU || kind(g0) == G_TEN) && ones) {
+        tian = 10 * value(g0) + value(g1);
+    } else if (g0 == G_CHU && g1 == (G_TEN | 1)) {
+        tian = 10;
+    } else if ((g0 == (G_DIGIT | 2) || g0 == (G_DIGIT | 3))
+        && g1 == (G_TEN | 1)) {
+        tian = 10 * value(g0);
+    }
+    if (tian == 0 || k + 2 != num) {
+        return status::malformed;
+    }
+    riqi out = {int16_t(nian), int8_t(2 * yue + run), tian};
+    if (!check_riqi(out)) {
+        return status::invalid;
+    }
+    rizi = out;
+    return status::ok;
+}
+
+// `庚午`, with an optional one of `UNITS` after, like `庚午年`; `zhu`
+// unchanged if not `ok`
+constexpr status parse_ganzhi(name_t text, ganzhi &zhu) noexcept {
+    using namespace _hz;
+    uint64_t len = text.size();
+    if (len % 3 != 0) {
+        return status::unknown;
+    }
+    if (len != 6 && len != 9) {
+        return status::malformed;
+    }
+    const char *str = text.data();
+    uint8_t gan = glyph(str), zhi = glyph(str + 3);
+    uint8_t unit = (len == 9) ? glyph(str + 6) : G_UNIT;
+    if (gan == NONE || zhi == NONE || unit == NONE) {
+        return status::unknown;
+    }
+    if (kind(gan) != G_GAN || kind(zhi) != G_ZHI || kind(unit) != G_UNIT) {
+        return status::malformed;
+    }
+    if ((gan ^ zhi) & 1) { // like `甲丑`
+        return status::invalid;
+    }
+    zhu = make_ganzhi(tiangan(value(gan)), dizhi(value(zhi)));
+    return status::ok;
+}
+
+// `立春`; `jie` unchanged if not `ok`
+constexpr status parse_jieqi(name_t text, jieqi &jie) noexcept {
+    using namespace _hz;
+    if (text.size() % 3 != 0) {
+        return status::unknown;
+    }
+    if (text.size() != 6) {
+        return status::malformed;
+    }
+    uint32_t c0 = decode(text.data()), c1 = decode(text.data() + 3);
+    uint8_t i = (c0 != 0 && c1 != 0) ? JIEQIS.find(c0 << 16 | c1) : NONE;
+    if (i == NONE) {
+        return status::unknown;
+    }
+    jie = jieqi(i);
+    return status::ok;
+}
+
+namespace batch { // pages of lines out, and lines in
+
+// `2024-02-04 癸卯年十二月廿五 戊戌日 立春`, `jieqi` on its first day
+inline constexpr uint64_t LINE_MAX = 56;
+
+// a line for each of udays in [`uday`, `uday + num`), all in range of
+// `riqi_range`; returns the end of bytes written
+constexpr char *format_days(
+    int32_t uday, char *str, uint64_t num
+) noexcept {
+    if (num == 0) {
+        return str;
+    }
+    for (tian_info info: riqi_range{uday, int32_t(uday + num - 1)}) {
+        auto [y, m, d] = info.locd;
+        char ymd[10] = {
+            char('0' + y / 1000), char('0' + y / 100 % 10),
+            char('0' + y / 10 % 10), char('0' + y % 10), '-',
+            char('0' + m / 10), char('0' + m % 10), '-',
+            char('0' + d / 10), char('0' + d % 10),
+        };
+        str = _hz::put(str, name_t(ymd, 10));
+        *str++ = ' ';
+        str = format_riqi(info.rizi, str);
+        *str++ = ' ';
+        str = _hz::put(str, name(info.zhu));
+        str = _hz::put(str, UNITS[2]);
+        if (info.jiao) {
+            *str++ = ' ';
+            str = _hz::put(str, name(info.jie));
+        }
+        *str++ = '\n';
+    }
+    return str;
+}
+
+// lines of `[beg, end)`, `num` at most, each by `parse_riqi` with an
+// optional `\r`; `riqi{}` on those not `ok`; returns lines read, the
+// last one ending at `end` or `\n`
+inline uint64_t parse_riqi(
+    const char *beg, const char *end,
+    riqi *rizis, status *stats, uint64_t num
+) noexcept {
+    uint64_t i = 0;
+    for (; i < num && beg < end; i++) {
+        const void *nl = std::memchr(beg, '\n', end - beg);
+        const char *eol = (nl != nullptr)
+            ? static_cast<const char *>(nl) : end;
+        uint64_t len = (eol - beg) - (eol > beg && eol[-1] == '\r');
+        riqi rizi = {};
+        stats[i] = iw17::hanzi::parse_riqi(name_t(beg, len), rizi);
+        rizis[i] = rizi;
+        beg = eol + 1;
+    }
+    return i;
+}
+
+} // namespace batch
+
+} // namespace iw17::hanzi
+
+#endif // IW_HANZI_HPP
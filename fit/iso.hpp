@@ -0,0 +1,178 @@
+#ifndef IW_ISO_HPP
+#define IW_ISO_HPP 20251016L
+
+#include <cstdint>
+#include <cstring>
+
+#include "dati.hpp"
+
+namespace iw17 {
+
+// `YYYY-MM-DDThh:mm:ss+hh:mm`, fixed width
+inline constexpr uint64_t ISO_LEN = 25;
+
+namespace _iso { // 8 bytes per word, little-endian
+
+inline constexpr uint64_t HIGHS = 0x8080808080808080;
+inline constexpr uint64_t ZEROS = 0x3030303030303030;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+inline constexpr bool HOST_LE = false;
+#else // MSVC targets little-endian hosts only
+inline constexpr bool HOST_LE = true;
+#endif // __BYTE_ORDER__
+
+// single loads and stores at runtime, bytes in constant evaluation
+constexpr uint64_t load8(const char *str) noexcept {
+    uint64_t word = 0;
+    if (HOST_LE && !prestd::is_constant_evaluated()) {
+        std::memcpy(&word, str, sizeof(word));
+        return word;
+    }
+    for (int i = 0; i < 8; i++) {
+        word |= uint64_t(uint8_t(str[i])) << (8 * i);
+    }
+    return word;
+}
+
+constexpr void store8(char *str, uint64_t word) noexcept {
+    if (HOST_LE && !prestd::is_constant_evaluated()) {
+        std::memcpy(str, &word, sizeof(word));
+        return;
+    }
+    for (int i = 0; i < 8; i++) {
+        str[i] = char(uint8_t(word >> (8 * i)));
+    }
+}
+
+// high bits set in bytes of `word` out of '0' to '9'
+constexpr uint64_t nondigits(uint64_t word) noexcept {
+    uint64_t below = ~((word | HIGHS) - ZEROS); // under '0'
+    uint64_t above = (word & ~HIGHS) + 0x4646464646464646; // over '9'
+    return (below | above | word) & HIGHS;
+}
+
+// bytes of `word` at `seps` equal to those of `want`, and digits
+// elsewhere
+constexpr bool match(
+    uint64_t word, uint64_t seps, uint64_t want
+) noexcept {
+    uint64_t digs = (word & ~seps) | (ZEROS & seps);
+    return (word & seps) == want && nondigits(digs) == 0;
+}
+
+// number of the 2 digits at bytes `i` and `i + 1` of `word`
+constexpr int8_t pair(uint64_t word, int i) noexcept {
+    uint32_t tens = (word >> (8 * i)) & 0x0f;
+    uint32_t ones = (word >> (8 * i + 8)) & 0x0f;
+    return int8_t(10 * tens + ones);
+}
+
+// 2 digits of `num` in [0, 99], in the lower 16 bits
+constexpr uint64_t digits2(uint32_t num) noexcept {
+    uint32_t tens = (num * 103) >> 10; // `num / 10`
+    return (0x3030 | tens) + (uint64_t(num - 10 * tens) << 8);
+}
+
+} // namespace _iso
+
+// false if not a valid `dati` in 0000 to 9999; zones in 15 minutes,
+// `-00:00` taken as UTC
+constexpr bool parse_dati(const char *str, dati &zond) noexcept {
+    using namespace _iso;
+    uint64_t w0 = load8(str), w1 = load8(str + 8);
+    uint64_t w2 = load8(str + 16);
+    uint32_t zm1 = uint32_t(uint8_t(str[24])) - '0';
+    // `YYYY-MM-`, `DDThh:mm`, `:ss+hh:m`
+    constexpr uint64_t S0 = 0xff0000ff00000000, P0 = 0x2d00002d00000000;
+    constexpr uint64_t S1 = 0x0000ff0000ff0000, P1 = 0x00003a0000540000;
+    constexpr uint64_t S2 = 0x00ff0000ff0000ff, P2 = 0x003a00002b00003a;
+    uint64_t tsep = (w1 >> 16) & 0xff; // `T` or ` `
+    uint64_t sign = (w2 >> 24) & 0xff; // `+` or `-`
+    w1 ^= (tsep == ' ') ? uint64_t(' ' ^ 'T') << 16 : 0;
+    w2 ^= (sign == '-') ? uint64_t('-' ^ '+') << 24 : 0;
+    if (!match(w0, S0, P0) || !match(w1, S1, P1)
+        || !match(w2, S2, P2) || zm1 > 9) {
+        return false;
+    }
+    int16_t y = int16_t(100 * pair(w0, 0) + pair(w0, 2));
+    int8_t zh = pair(w2, 4), zm = int8_t(10 * ((w2 >> 56) & 0x0f) + zm1);
+    int32_t quar = 4 * zh + zm / 15;
+    if (zm >= 60 || zm % 15 != 0 || quar > (sign == '-' ? 48 : 56)) {
+        return false;
+    }
+    quar = (sign == '-') ? -quar : quar;
+    zond = dati{
+        y, pair(w0, 5), pair(w1, 0),
+        pair(w1, 3), pair(w1, 6), pair(w2, 1),
+        tzinfo(int32_t(tzinfo::utc) + quar),
+    };
+    return check_dati(zond);
+}
+
+// `ISO_LEN` bytes, or none if not valid or the year out of 0 to 9999;
+// returns the end of bytes written
+constexpr char *format_dati(dati zond, char *str) noexcept {
+    using namespace _iso;
+    if (!check_dati(zond) || zond.year < 0 || zond.year > 9999) {
+        return str;
+    }
+    auto [y, m, d, hh, mm, ss, tz] = zond;
+    int32_t quar = int32_t(tz) - int32_t(tzinfo::utc);
+    uint64_t sign = (quar < 0) ? '-' : '+';
+    uint32_t zabs = (quar < 0) ? -quar : quar;
+    uint64_t zmin = digits2(15 * (zabs & 3));
+    uint64_t w0 = digits2(y / 100) | digits2(y % 100) << 16
+        | uint64_t('-') << 32 | digits2(m) << 40 | uint64_t('-') << 56;
+    uint64_t w1 = digits2(d) | uint64_t('T') << 16
+        | digits2(hh) << 24 | uint64_t(':') << 40 | digits2(mm) << 48;
+    uint64_t w2 = uint64_t(':') | digits2(ss) << 8 | sign << 24
+        | digits2(zabs >> 2) << 32 | uint64_t(':') << 48 | zmin << 56;
+    store8(str, w0), store8(str + 8, w1), store8(str + 16, w2);
+    str[24] = char(zmin >> 8);
+    return str + ISO_LEN;
+}
+
+namespace batch { // lines in, arrays out, and back
+
+// lines of `[beg, end)`, `num` at most, each of `ISO_LEN` bytes with
+// an optional `\r`; others as `dati{}`, which fails `check_dati`;
+// returns lines read, the last one ending at `end` or `\n`
+inline uint64_t parse_dati(
+    const char *beg, const char *end, dati *zonds, uint64_t num
+) noexcept {
+    uint64_t i = 0;
+    for (; i < num && beg < end; i++) {
+        const char *eol = beg + ISO_LEN;
+        if (end - beg <= int64_t(ISO_LEN) || *eol != '\n') { // searched
+            const void *nl = std::memchr(beg, '\n', end - beg);
+            eol = (nl != nullptr) ? static_cast<const char *>(nl) : end;
+        }
+        int64_t len = (eol - beg) - (eol > beg && eol[-1] == '\r');
+        dati zond = {};
+        if (len != int64_t(ISO_LEN) || !iw17::parse_dati(beg, zond)) {
+            zond = dati{};
+        }
+        zonds[i] = zond;
+        beg = eol + 1;
+    }
+    return i;
+}
+
+// a line of `ISO_LEN + 1` bytes each, empty if not formatted; returns
+// the end of bytes written
+inline char *format_dati(
+    const dati *zonds, char *str, uint64_t num
+) noexcept {
+    for (uint64_t i = 0; i < num; i++) {
+        str = iw17::format_dati(zonds[i], str);
+        *str++ = '\n';
+    }
+    return str;
+}
+
+} // namespace batch
+
+} // namespace iw17
+
+#endif // IW_ISO_HPP
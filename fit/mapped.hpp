@@ -0,0 +1,416 @@
+#ifndef IW_MAPPED_HPP
+#define IW_MAPPED_HPP 20251016L
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h>
+#else // POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+#include "nongli.hpp"
+
+// data of any range, by `coefs.py --binary`, mapped at runtime
+namespace iw17::mapped {
+
+// version 1, little-endian: `layout` at offset 0, then 4 tables at
+// offsets of their `table_ref`s, each aligned to 64 bytes; tables are
+// those in `data.hpp`, with pages of YD and JS joined into one each
+//
+// version 2, by `coefs.py --era`: `directory` at offset 0, then
+// `segment`s of consecutive eras, each with a `layout` of version 1
+// fitted on its own, whose tables are at offsets from the file start
+inline constexpr char MAGIC[8] = {
+    'I', 'W', 'N', 'O', 'N', 'G', 'L', 'I',
+};
+inline constexpr uint32_t VERSION = 1;
+inline constexpr uint32_t VERSION_ERAS = 2;
+inline constexpr uint64_t ALIGN = 64;
+
+struct table_ref {
+    uint64_t offset;
+    uint64_t bytes;
+};
+
+struct layout { // 1664 bytes, no padding
+    char magic[8];
+    uint32_t version;
+    uint32_t head_bytes; // `sizeof(layout)`
+    uint64_t file_bytes;
+    int16_t nian_min, nian_max, sui_min, sui_max, year_min, year_max;
+    int32_t cyue_min, cyue_max, cjie_min, cjie_max;
+    int32_t reserved; // 0
+    int64_t ny_bits, ny_coef[4];
+    int64_t yd_bits, yd_coef[4];
+    int64_t dy_bits, dy_coef[3];
+    int64_t yn_bits, yn_coef[3];
+    int64_t js_bits, js_clin[2], js_coef[24][7];
+    int64_t sj_bits, sj_coef[3];
+    table_ref nr_runs, ny_resy, yd_resd, js_ress;
+};
+
+static_assert(sizeof(layout) == 1664, "layout of version 1");
+
+struct directory { // 32 bytes, followed by `segments + 1` entries
+    char magic[8];
+    uint32_t version; // `VERSION_ERAS`
+    uint32_t head_bytes; // `sizeof(directory)`
+    uint64_t file_bytes;
+    uint32_t segments;
+    int32_t reserved; // 0
+};
+
+struct segment { // 32 bytes, first keys of an era
+    int32_t nian_min, cyue_min, cjie_min, uday_min;
+    int64_t usec_min;
+    uint64_t offset; // of its `layout`, 0 in the last entry of ends
+};
+
+static_assert(sizeof(directory) == 32, "directory of version 2");
+static_assert(sizeof(segment) == 32, "segment of version 2");
+
+// checks `[base, base + size)` before use, without copies, with the
+// `layout` at `base + at` and its tables at offsets from `base`
+inline const layout *check_layout(
+    const void *base, uint64_t size, uint64_t at = 0
+) noexcept {
+    if (base == nullptr || at % ALIGN != 0 || size < sizeof(layout)
+        || at > size - sizeof(layout)) {
+        return nullptr;
+    }
+    const uint8_t *from = static_cast<const uint8_t *>(base);
+    const layout *head = reinterpret_cast<const layout *>(from + at);
+    if (std::memcmp(head->magic, MAGIC, sizeof(MAGIC)) != 0
+        || head->version != VERSION
+        || head->head_bytes != sizeof(layout)
+        || head->file_bytes != size) {
+        return nullptr; // also big-endian files or hosts
+    }
+    if (head->nian_min > head->nian_max
+        || head->cyue_min > head->cyue_max
+        || head->cjie_min > head->cjie_max) {
+        return nullptr;
+    }
+    // items read at most, up to `nian_max + 1` and `cyue_max + 1`
+    uint64_t nians = int64_t(head->nian_max) - head->nian_min + 2;
+    uint64_t cyues = int64_t(head->cyue_max) - head->cyue_min + 2;
+    uint64_t ijie = int64_t(head->cjie_max) - head->cjie_min;
+    const table_ref refs[] = {
+        head->nr_runs, head->ny_resy, head->yd_resd, head->js_ress,
+    };
+    const uint64_t needs[] = {
+        (nians + 1) / 2, (nians + 7) / 8, (cyues + 3) / 4,
+        ijie + (ijie >> 1) + 2,
+    };
+    for (int i = 0; i < 4; i++) {
+        auto [offset, bytes] = refs[i];
+        if (offset < sizeof(layout) || offset % ALIGN != 0
+            || offset > size || bytes > size - offset
+            || bytes < needs[i]) {
+            return nullptr;
+        }
+    }
+    return head;
+}
+
+// checks a file of version 2 and all its segments, consecutive
+inline const segment *check_directory(
+    const void *base, uint64_t size
+) noexcept {
+    if (base == nullptr || size < sizeof(directory)) {
+        return nullptr;
+    }
+    const uint8_t *from = static_cast<const uint8_t *>(base);
+    const directory *head = static_cast<const directory *>(base);
+    if (std::memcmp(head->magic, MAGIC, sizeof(MAGIC)) != 0
+        || head->version != VERSION_ERAS
+        || head->head_bytes != sizeof(directory)
+        || head->file_bytes != size || head->segments == 0) {
+        return nullptr;
+    }
+    // `segments + 1` entries, each within `size`
+    uint64_t entries = (size - sizeof(directory)) / sizeof(segment);
+    if (head->segments >= entries) {
+        return nullptr;
+    }
+    const segment *segs = reinterpret_cast<const segment *>(
+        from + sizeof(directory));
+    for (uint32_t iseg = 0; iseg < head->segments; iseg++) {
+        const segment &seg = segs[iseg], &next = segs[iseg + 1];
+        const layout *info = check_layout(base, size, seg.offset);
+        if (info == nullptr || info->nian_min != seg.nian_min
+            || info->cyue_min != seg.cyue_min
+            || info->cjie_min != seg.cjie_min
+            || next.nian_min != info->nian_max + 1
+            || next.cyue_min != info->cyue_max + 1
+            || next.cjie_min != info->cjie_max + 1
+            || next.uday_min <= seg.uday_min
+            || next.usec_min <= seg.usec_min) {
+            return nullptr;
+        }
+    }
+    return segs;
+}
+
+// tables of one file, mapped read-only and shared across processes
+struct dataset {
+
+dataset() = default;
+
+explicit dataset(const char *path) noexcept {
+    this->open(path);
+}
+
+dataset(const dataset &) = delete;
+
+dataset &operator=(const dataset &) = delete;
+
+~dataset() {
+    this->close();
+}
+
+// false if not mapped or not valid, leaving `*this` closed
+bool open(const char *path) noexcept {
+    this->close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size = {};
+    HANDLE fmap = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        fmap = CreateFileMappingA(file, nullptr, PAGE_READONLY,
+            0, 0, nullptr);
+    }
+    CloseHandle(file);
+    if (fmap == nullptr) {
+        return false;
+    }
+    void *base = MapViewOfFile(fmap, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(fmap);
+    if (base == nullptr) {
+        return false;
+    }
+    view = base, view_bytes = uint64_t(size.QuadPart);
+#else // POSIX
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info = {};
+    void *base = MAP_FAILED;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+        base = ::mmap(nullptr, size_t(info.st_size), PROT_READ,
+            MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+    view = base, view_bytes = uint64_t(info.st_size);
+#endif // _WIN32
+    if (!this->attach(view, view_bytes)) {
+        this->close();
+        return false;
+    }
+    return true;
+}
+
+// over memory owned by the caller, e.g. an embedded copy
+bool attach(const void *base, uint64_t size) noexcept {
+    bytes = static_cast<const uint8_t *>(base);
+    segs = check_directory(base, size);
+    if (segs != nullptr) {
+        nseg = static_cast<const directory *>(base)->segments;
+        return true;
+    }
+    const layout *head = check_layout(base, size);
+    if (head == nullptr) {
+        bytes = nullptr, nseg = 0;
+        return false;
+    }
+    // version 1 as one segment, its ends only for `find`
+    segs = one, nseg = 1;
+    one[0] = {head->nian_min, head->cyue_min, head->cjie_min, 0, 0, 0};
+    one[1] = {head->nian_max + 1, head->cyue_max + 1,
+        head->cjie_max + 1, 0, 0, 0};
+    return true;
+}
+
+void close() noexcept {
+    if (view != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(view);
+#else // POSIX
+        ::munmap(view, size_t(view_bytes));
+#endif // _WIN32
+    }
+    view = nullptr, view_bytes = 0;
+    bytes = nullptr, segs = nullptr, nseg = 0;
+}
+
+bool valid() const noexcept {
+    return nseg != 0;
+}
+
+uint32_t segments() const noexcept {
+    return nseg;
+}
+
+// limits and coefficients of segment `iseg`, only if `valid()`
+const layout &info(uint32_t iseg = 0) const noexcept {
+    return *reinterpret_cast<const layout *>(bytes + segs[iseg].offset);
+}
+
+// as those in `nongli.hpp`, within limits of all `info(iseg)`
+
+int8_t nian_to_run(int16_t nian) const noexcept {
+    const layout &head = this->info(this->find<&segment::nian_min>(nian));
+    const uint8_t *nr = bytes + head.nr_runs.offset;
+    auto [iloc, ibit] = math::cdivmod<uint32_t>(
+        nian - head.nian_min, 2);
+    return (nr[iloc] >> (4 * ibit)) & 0b1111;
+}
+
+int32_t nian_to_cyue(int16_t nian) const noexcept {
+    const layout &head = this->info(this->find<&segment::nian_min>(nian));
+    const uint8_t *ny = bytes + head.ny_resy.offset;
+    const int64_t *coef = head.ny_coef;
+    int64_t plin = coef[0] * nian + coef[1];
+    int64_t bfit = coef[2] * nian + coef[3];
+    auto [iloc, ibit] = math::cdivmod<uint32_t>(
+        nian - head.nian_min, 8);
+    int32_t resy = (ny[iloc] >> ibit) & 1;
+    return plin + (bfit >> head.ny_bits) + resy;
+}
+
+int32_t cyue_to_uday(int32_t cyue) const noexcept {
+    const layout &head = this->info(this->find<&segment::cyue_min>(cyue));
+    const uint8_t *yd = bytes + head.yd_resd.offset;
+    const int64_t *coef = head.yd_coef;
+    int64_t plin = coef[0] * cyue + coef[1];
+    int64_t bfit = coef[2] * cyue + coef[3];
+    auto [iloc, ibit] = math::cdivmod<uint32_t>(
+        cyue - head.cyue_min, 4);
+    int32_t resd = (yd[iloc] >> (2 * ibit)) & 0b0011;
+    return plin + (bfit >> head.yd_bits) + resd;
+}
+
+int32_t uday_to_cyue(int32_t uday) const noexcept {
+    const layout &head = this->info(this->find<&segment::uday_min>(uday));
+    const int64_t *coef = head.dy_coef;
+    int64_t bfit = coef[1] * uday + coef[2];
+    int32_t pred = coef[0] + (bfit >> head.dy_bits);
+    return pred - (uday < this->cyue_to_uday(pred));
+}
+
+int16_t cyue_to_nian(int32_t cyue) const noexcept {
+    const layout &head = this->info(this->find<&segment::cyue_min>(cyue));
+    const int64_t *coef = head.yn_coef;
+    int64_t bfit = coef[1] * cyue + coef[2];
+    int32_t pred = coef[0] + (bfit >> head.yn_bits);
+    return pred - (cyue < this->nian_to_cyue(pred));
+}
+
+riqi uday_to_riqi(int32_t uday) const noexcept {
+    int32_t cyue = this->uday_to_cyue(uday);
+    int16_t nian = this->cyue_to_nian(cyue);
+    int8_t nyue = cyue - this->nian_to_cyue(nian);
+    int8_t ryue = nyue_to_ryue(nyue, this->nian_to_run(nian));
+    int8_t tian = uday - this->cyue_to_uday(cyue) + 1;
+    return riqi{nian, ryue, tian};
+}
+
+int32_t riqi_to_uday(riqi rizi) const noexcept {
+    auto [nian, ryue, tian] = rizi;
+    int8_t nyue = ryue_to_nyue(ryue, this->nian_to_run(nian));
+    int32_t cyue = this->nian_to_cyue(nian) + nyue;
+    return this->cyue_to_uday(cyue) + tian - 1;
+}
+
+int64_t cjie_to_usec(int32_t cjie) const noexcept {
+    const layout &head = this->info(this->find<&segment::cjie_min>(cjie));
+    const uint8_t *js = bytes + head.js_ress.offset;
+    auto [sui, jie] = cjie_to_shihou(cjie);
+    int64_t plin = head.js_clin[0] * sui + head.js_clin[1];
+    const int64_t *coef = head.js_coef[int8_t(jie)];
+    int64_t nb = head.js_bits, pfit = coef[0];
+    pfit = (pfit * sui >> nb) + coef[1];
+    pfit = (pfit * sui >> nb) + coef[2];
+    pfit = (pfit * sui >> nb) + coef[3];
+    pfit = (pfit * sui >> nb) + coef[4];
+    pfit = (pfit * sui >> nb) + coef[5];
+    pfit = (pfit * sui >> nb) + coef[6];
+    uint32_t ijie = cjie - head.cjie_min, isub = ijie + (ijie >> 1);
+    uint32_t pair = (uint32_t(js[isub + 1]) << 8) | js[isub];
+    int64_t ress = (cjie & 1) ? (pair >> 4) : (pair & 0x0fff);
+    return plin + pfit + ress;
+}
+
+int32_t usec_to_cjie(int64_t usec) const noexcept {
+    const layout &head = this->info(this->find<&segment::usec_min>(usec));
+    const int64_t *coef = head.sj_coef;
+    int64_t pbit = coef[1] * usec >> head.sj_bits;
+    int64_t plin = (pbit + coef[2]) >> head.sj_bits;
+    int32_t pred = plin + coef[0];
+    return pred - (usec < this->cjie_to_usec(pred));
+}
+
+shihou usec_to_shihou(int64_t usec) const noexcept {
+    return cjie_to_shihou(this->usec_to_cjie(usec));
+}
+
+bazi usec_to_bazi(int64_t usec, double lon) const noexcept {
+    int32_t cjie = this->usec_to_cjie(usec);
+    int64_t last = this->cjie_to_usec(cjie);
+    int64_t next = this->cjie_to_usec(cjie + 1);
+    return _rst::span_to_bazi(usec, {last, next, cjie}, lon);
+}
+
+private:
+
+// segment of `key` by interpolation over the ends, then at most a
+// step or two for eras of even lengths, whatever the number of eras
+template <auto KEY, typename T>
+uint32_t find(T key) const noexcept {
+    if (nseg == 1) {
+        return 0;
+    }
+    int64_t first = segs[0].*KEY, span = (segs[nseg].*KEY) - first;
+    int64_t diff = int64_t(key) - first;
+    uint32_t iseg = (diff <= 0) ? 0 : (diff >= span) ? nseg - 1
+        : uint32_t(diff * nseg / span);
+    while (iseg + 1 < nseg && key >= segs[iseg + 1].*KEY) {
+        iseg += 1;
+    }
+    while (iseg > 0 && key < segs[iseg].*KEY) {
+        iseg -= 1;
+    }
+    return iseg;
+}
+
+const uint8_t *bytes = nullptr;
+const segment *segs = nullptr;
+uint32_t nseg = 0;
+segment one[2] = {}; // directory of a file of version 1
+void *view = nullptr; // mapped by `open`, not by `attach`
+uint64_t view_bytes = 0;
+
+}; // struct dataset
+
+} // namespace iw17::mapped
+
+#endif // IW_MAPPED_HPP
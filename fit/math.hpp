@@ -1,5 +1,5 @@
 #ifndef IW_MATH_HPP
-#define IW_MATH_HPP 20250205L
+#define IW_MATH_HPP 20251016L
 
 #include <cstdint>
 #include <type_traits>
@@ -229,10 +229,24 @@ constexpr fix64 fast_div(int64_t a, int64_t b) noexcept {
     return fill_fix64(av / b);
 }
 
-// large numerator and small denominator
+// large numerator and any denominator
 constexpr fix64 fair_div(int64_t a, int64_t b) noexcept {
     auto [quot, rem] = cdivmod<int64_t>(a, b);
-    return make_fix64(quot) + fast_div(rem, b);
+    uint64_t ur = (rem < 0) ? 0 - uint64_t(rem) : uint64_t(rem);
+    uint64_t ub = (b < 0) ? 0 - uint64_t(b) : uint64_t(b);
+    // fractional bits in steps, `ur` shifted within 64 bits
+    uint64_t frac = 0;
+    for (int64_t left = fix::FBITS; left > 0;) {
+        int64_t step = left;
+        while (ur >> (64 - step) != 0) {
+            step -= 1;
+        }
+        ur <<= step;
+        frac = (frac << step) | (ur / ub);
+        ur %= ub, left -= step;
+    }
+    int64_t fv = ((rem < 0) != (b < 0)) ? -int64_t(frac) : int64_t(frac);
+    return make_fix64(quot) + fill_fix64(fv);
 }
 
 namespace _tiny {
@@ -330,6 +344,58 @@ constexpr fix64 sinq(fix64 x) noexcept {
     }
 }
 
+namespace _lut { // quarter-wave table, 2nd-order Taylor in between
+
+// 256 steps per quarter round
+constexpr int64_t LBITS = 8;
+constexpr int64_t RBITS = fix::FBITS - LBITS;
+constexpr uint64_t LSIZE = (1_u64 << LBITS) + 1;
+
+template <uint64_t N>
+struct wave_fix64 {
+    fix64 vals[N];
+};
+
+// sin(PI/2 * i / 256) for i in [0, 256]
+template <uint64_t N>
+constexpr wave_fix64<N> sin_wave() noexcept {
+    wave_fix64<N> tab = {};
+    for (uint64_t i = 0; i < N; i++) {
+        tab.vals[i] = sinq(fill_fix64(int64_t(i) << RBITS));
+    }
+    return tab;
+}
+
+// template, evaluated only if used
+template <uint64_t N = LSIZE>
+inline constexpr wave_fix64<N> SIN_WAVE = sin_wave<N>();
+
+// sinq(x) = sin(PI/2 * x), error within 4e-8
+constexpr fix64 sinq(fix64 x) noexcept {
+    constexpr fix64 HALF_PI = make_fix64(1.570796326794896619231);
+    constexpr int64_t RPART = (1_i64 << RBITS) - 1;
+    uint64_t xv = pour_int64(x);
+    uint64_t quad = (xv >> fix::FBITS) & 3;
+    uint64_t frac = xv & fix::FPART;
+    uint64_t iloc = frac >> RBITS;
+    fix64 dlt = fast_mul(fill_fix64(frac & RPART), HALF_PI);
+    fix64 sinv = SIN_WAVE<>.vals[iloc];
+    fix64 cosv = SIN_WAVE<>.vals[LSIZE - 1 - iloc];
+    // odd quadrants: cos(a + d), else sin(a + d)
+    fix64 base = (quad & 1) ? cosv : sinv;
+    fix64 drv1 = (quad & 1) ? -sinv : cosv;
+    fix64 half = fast_mul(fast_mul(dlt, dlt) >> 1, base);
+    fix64 resv = base + fast_mul(drv1, dlt) - half;
+    return (quad & 2) ? -resv : resv;
+}
+
+// cosq(x) = cos(PI/2 * x), error within 4e-8
+constexpr fix64 cosq(fix64 x) noexcept {
+    return _lut::sinq(x + make_fix64(1));
+}
+
+} // namespace _lut
+
 } // namespace iw17::math
 
 #endif // IW_MATH_HPP
@@ -1,15 +1,40 @@
 #ifndef IW_NONGLI_HPP
-#define IW_NONGLI_HPP 20250203L
+#define IW_NONGLI_HPP 20251016L
 
 #include <cstdint>
 
-#include "data.hpp"
 #include "dati.hpp"
 #include "math.hpp"
+#include "trim.hpp"
+
+// dense backend: flat tables in place of fittings, more memory
+#ifndef IW_NONGLI_DENSE
+#define IW_NONGLI_DENSE 0
+#endif // IW_NONGLI_DENSE
+
+// uday index: `uday_to_riqi` by a single probe, more memory
+#ifndef IW_NONGLI_UDAY_INDEX
+#define IW_NONGLI_UDAY_INDEX 0
+#endif // IW_NONGLI_UDAY_INDEX
+
+// jie index: `usec_to_cjie` by a single probe, more memory
+#ifndef IW_NONGLI_JIE_INDEX
+#define IW_NONGLI_JIE_INDEX 0
+#endif // IW_NONGLI_JIE_INDEX
+
+// EoT cache: `usec_to_bazi` by daily EoT, exact near boundaries
+#ifndef IW_NONGLI_EOT_CACHE
+#define IW_NONGLI_EOT_CACHE 0
+#endif // IW_NONGLI_EOT_CACHE
+
+// table trigonometry: EoT of `usec_to_bazi` by `math::_lut`
+#ifndef IW_NONGLI_LUT_TRIG
+#define IW_NONGLI_LUT_TRIG 0
+#endif // IW_NONGLI_LUT_TRIG
 
 namespace iw17 {
 
-using namespace data::limits;
+using namespace trim::limits;
 
 constexpr int64_t uday_to_usec(int32_t uday) noexcept {
     return int64_t(86400) * uday - 28800;
@@ -35,51 +60,115 @@ constexpr int8_t nyue_to_ryue(int8_t nyue, int8_t run) noexcept {
 
 constexpr int8_t nian_to_run(int16_t nian) noexcept {
     auto [iloc, ibit] = math::cdivmod<uint16_t>(nian - NIAN_MIN, 2);
-    return (data::NR_RUNS[iloc] >> (4 * ibit)) & 0b1111;
+    return (trim::NR_RUNS[iloc] >> (4 * ibit)) & 0b1111;
 }
 
 namespace _fit { // NY: nian_to_cyue
 
 constexpr int32_t ny_pred(int16_t nian) noexcept {
-    int64_t plin = data::NY_COEF[0] * nian + data::NY_COEF[1];
-    int64_t bfit = data::NY_COEF[2] * nian + data::NY_COEF[3];
-    return plin + (bfit >> data::NY_BITS);
+    int64_t plin = trim::NY_COEF[0] * nian + trim::NY_COEF[1];
+    int64_t bfit = trim::NY_COEF[2] * nian + trim::NY_COEF[3];
+    return plin + (bfit >> trim::NY_BITS);
 }
 
 constexpr int32_t ny_resy(int16_t nian) noexcept {
     auto [iloc, ibit] = math::cdivmod<uint32_t>(nian - NIAN_MIN, 8);
-    return (data::NY_RESY[iloc] >> ibit) & 1;
+    return (trim::NY_RESY[iloc] >> ibit) & 1;
 }
 
-} // namespace _fit
-
 constexpr int32_t nian_to_cyue(int16_t nian) noexcept {
-    int32_t pred = _fit::ny_pred(nian);
-    int32_t resy = _fit::ny_resy(nian);
+    int32_t pred = ny_pred(nian);
+    int32_t resy = ny_resy(nian);
     return pred + resy;
 }
 
+} // namespace _fit
+
 namespace _fit { // YD: cyue_to_uday
 
 constexpr int32_t yd_pred(int32_t cyue) noexcept {
-    int64_t plin = data::YD_COEF[0] * cyue + data::YD_COEF[1];
-    int64_t bfit = data::YD_COEF[2] * cyue + data::YD_COEF[3];
-    return plin + (bfit >> data::YD_BITS);
+    int64_t plin = trim::YD_COEF[0] * cyue + trim::YD_COEF[1];
+    int64_t bfit = trim::YD_COEF[2] * cyue + trim::YD_COEF[3];
+    return plin + (bfit >> trim::YD_BITS);
 }
 
 constexpr int32_t yd_resd(int32_t cyue) noexcept {
     auto [isub, ibit] = math::cdivmod<uint32_t>(cyue - CYUE_MIN, 4);
-    auto [iarr, iloc] = math::cdivmod<uint32_t>(isub, data::YD_PAGE);
-    const uint8_t *arrd = data::YD_ARRD[iarr];
+    auto [iarr, iloc] = math::cdivmod<uint32_t>(isub, trim::YD_PAGE);
+    const uint8_t *arrd = trim::YD_ARRD[iarr];
     return (arrd[iloc] >> (2 * ibit)) & 0b0011;
 }
 
+constexpr int32_t cyue_to_uday(int32_t cyue) noexcept {
+    int32_t pred = yd_pred(cyue);
+    int32_t resd = yd_resd(cyue);
+    return pred + resd;
+}
+
 } // namespace _fit
 
+namespace _tab { // dense: fittings evaluated into flat tables
+
+template <uint64_t N>
+struct dense_i32 {
+    int32_t vals[N];
+};
+
+// `nian`s in [NIAN_MIN, NIAN_MAX + 1]
+inline constexpr uint64_t NY_SIZE = NIAN_MAX + 2 - NIAN_MIN;
+
+// `cyue`s in [CYUE_MIN, CYUE_MAX + 1]
+inline constexpr uint64_t YD_SIZE = CYUE_MAX + 2 - CYUE_MIN;
+
+template <uint64_t N>
+constexpr dense_i32<N> ny_dense() noexcept {
+    dense_i32<N> tab = {};
+    for (uint64_t i = 0; i < N; i++) {
+        tab.vals[i] = _fit::nian_to_cyue(int16_t(NIAN_MIN + i));
+    }
+    return tab;
+}
+
+template <uint64_t N>
+constexpr dense_i32<N> yd_dense() noexcept {
+    dense_i32<N> tab = {};
+    for (uint64_t i = 0; i < N; i++) {
+        tab.vals[i] = _fit::cyue_to_uday(CYUE_MIN + int32_t(i));
+    }
+    return tab;
+}
+
+// templates, evaluated only if used
+template <uint64_t N = NY_SIZE>
+inline constexpr dense_i32<N> NY_DENSE = ny_dense<N>();
+
+template <uint64_t N = YD_SIZE>
+inline constexpr dense_i32<N> YD_DENSE = yd_dense<N>();
+
+constexpr int32_t nian_to_cyue(int16_t nian) noexcept {
+    return NY_DENSE<>.vals[nian - NIAN_MIN];
+}
+
 constexpr int32_t cyue_to_uday(int32_t cyue) noexcept {
-    int32_t pred = _fit::yd_pred(cyue);
-    int32_t resd = _fit::yd_resd(cyue);
-    return pred + resd;
+    return YD_DENSE<>.vals[cyue - CYUE_MIN];
+}
+
+} // namespace _tab
+
+constexpr int32_t nian_to_cyue(int16_t nian) noexcept {
+#if IW_NONGLI_DENSE
+    return _tab::nian_to_cyue(nian);
+#else // IW_NONGLI_DENSE
+    return _fit::nian_to_cyue(nian);
+#endif // IW_NONGLI_DENSE
+}
+
+constexpr int32_t cyue_to_uday(int32_t cyue) noexcept {
+#if IW_NONGLI_DENSE
+    return _tab::cyue_to_uday(cyue);
+#else // IW_NONGLI_DENSE
+    return _fit::cyue_to_uday(cyue);
+#endif // IW_NONGLI_DENSE
 }
 
 constexpr int8_t days_in_cyue(int32_t cyue) noexcept {
@@ -88,17 +177,135 @@ constexpr int8_t days_in_cyue(int32_t cyue) noexcept {
     return next - ud01;
 }
 
+namespace _tab { // NI: `nian` summaries, 8 bytes each
+
+struct nian_info {
+    int32_t ud01; // uday of chunjie
+    int32_t cy01; // `cyue` of chunjie
+    uint16_t mask; // bit `nyue` set if 30 days
+    int8_t run;
+};
+
+// bits: 0-12 `mask`, 13-16 `run`, 17-31 `cy01`, 32-63 `ud01`
+constexpr uint64_t pack_info(nian_info info) noexcept {
+    auto [ud01, cy01, mask, run] = info;
+    return uint64_t(uint32_t(ud01)) << 32
+        | uint64_t(cy01 - CYUE_MIN) << 17
+        | uint64_t(run) << 13 | mask;
+}
+
+constexpr nian_info unpack_info(uint64_t pack) noexcept {
+    int32_t ud01 = int32_t(uint32_t(pack >> 32));
+    int32_t cy01 = int32_t((pack >> 17) & 0x7fff) + CYUE_MIN;
+    uint16_t mask = pack & 0x1fff;
+    int8_t run = (pack >> 13) & 0xf;
+    return nian_info{ud01, cy01, mask, run};
+}
+
+// `nian`s in [NIAN_MIN, NIAN_MAX]
+inline constexpr uint64_t NI_SIZE = NIAN_MAX + 1 - NIAN_MIN;
+
+static_assert(CYUE_MAX - CYUE_MIN < 0x8000, "15 bits for `cyue`");
+
+template <uint64_t N>
+struct packs_u64 {
+    uint64_t packs[N];
+};
+
+template <uint64_t N>
+constexpr packs_u64<N> ni_packs() noexcept {
+    packs_u64<N> tab = {};
+    int32_t cy01 = _fit::nian_to_cyue(NIAN_MIN);
+    int32_t udnx = _fit::cyue_to_uday(cy01);
+    for (uint64_t i = 0; i < N; i++) {
+        int16_t nian = NIAN_MIN + int16_t(i);
+        int32_t cynx = _fit::nian_to_cyue(nian + 1);
+        int32_t ud01 = udnx;
+        uint16_t mask = 0;
+        for (int32_t cyue = cy01; cyue < cynx; cyue++) {
+            int32_t ud00 = udnx;
+            udnx = _fit::cyue_to_uday(cyue + 1);
+            mask |= uint16_t(udnx - ud00 == 30) << (cyue - cy01);
+        }
+        int8_t run = nian_to_run(nian);
+        tab.packs[i] = pack_info(nian_info{ud01, cy01, mask, run});
+        cy01 = cynx;
+    }
+    return tab;
+}
+
+// template, evaluated only if used
+template <uint64_t N = NI_SIZE>
+inline constexpr packs_u64<N> NI_PACKS = ni_packs<N>();
+
+constexpr nian_info nian_to_info(int16_t nian) noexcept {
+    return unpack_info(NI_PACKS<>.packs[nian - NIAN_MIN]);
+}
+
+// days from chunjie to the 1st of `nyue`
+constexpr int32_t nyue_to_days(nian_info info, int8_t nyue) noexcept {
+    uint16_t prev = info.mask & ((1u << nyue) - 1);
+    return 29 * nyue + prestd::popcount(prev);
+}
+
+constexpr int8_t nyue_to_ndays(nian_info info, int8_t nyue) noexcept {
+    return 29 + ((info.mask >> nyue) & 1);
+}
+
 constexpr riqi riqi_to_hui(riqi nianyue) noexcept {
+    nian_info info = nian_to_info(nianyue.nian);
+    int8_t nyue = ryue_to_nyue(nianyue.ryue, info.run);
+    nianyue.tian = nyue_to_ndays(info, nyue);
+    return nianyue;
+}
+
+constexpr bool check_riqi(riqi rizi) noexcept {
+    auto [nian, ryue, tian] = rizi;
+    if (nian < NIAN_MIN || nian > NIAN_MAX) {
+        return false;
+    }
+    if (ryue < 2 || ryue > 25 || tian < 1) {
+        return false;
+    }
+    nian_info info = nian_to_info(nian);
+    if (ryue & 1 && ryue >> 1 != info.run) {
+        return false;
+    }
+    int8_t nyue = ryue_to_nyue(ryue, info.run);
+    return tian <= nyue_to_ndays(info, nyue);
+}
+
+constexpr int32_t riqi_to_uday(riqi rizi) noexcept {
+    auto [nian, ryue, tian] = rizi;
+    nian_info info = nian_to_info(nian);
+    int8_t nyue = ryue_to_nyue(ryue, info.run);
+    return info.ud01 + nyue_to_days(info, nyue) + tian - 1;
+}
+
+} // namespace _tab
+
+constexpr riqi riqi_to_hui(riqi nianyue) noexcept {
+#if IW_NONGLI_DENSE
+    return _tab::riqi_to_hui(nianyue);
+#else // IW_NONGLI_DENSE
     auto [nian, ryue, _] = nianyue;
     int8_t run = nian_to_run(nian);
     int8_t nyue = ryue_to_nyue(ryue, run);
     int32_t cy01 = nian_to_cyue(nian);
     nianyue.tian = days_in_cyue(cy01 + nyue);
     return nianyue;
+#endif // IW_NONGLI_DENSE
 }
 
+// false for `nian`s out of [NIAN_MIN, NIAN_MAX] on all backends
 constexpr bool check_riqi(riqi rizi) noexcept {
     auto [nian, ryue, tian] = rizi;
+    if (nian < NIAN_MIN || nian > NIAN_MAX) {
+        return false;
+    }
+#if IW_NONGLI_DENSE
+    return _tab::check_riqi(rizi);
+#else // IW_NONGLI_DENSE
     if (ryue < 2 || ryue > 25 || tian < 1) {
         return false;
     }
@@ -109,23 +316,99 @@ constexpr bool check_riqi(riqi rizi) noexcept {
     int8_t nyue = ryue_to_nyue(ryue, run);
     int32_t cy01 = nian_to_cyue(nian);
     return tian <= days_in_cyue(cy01 + nyue);
+#endif // IW_NONGLI_DENSE
 }
 
 constexpr int32_t uday_to_cyue(int32_t uday) noexcept {
-    int32_t bfit = data::DY_COEF[1] * uday + data::DY_COEF[2];
-    int32_t pred = data::DY_COEF[0] + (bfit >> data::DY_BITS);
+    int32_t bfit = trim::DY_COEF[1] * uday + trim::DY_COEF[2];
+    int32_t pred = trim::DY_COEF[0] + (bfit >> trim::DY_BITS);
     int32_t pday = cyue_to_uday(pred);
     return pred - (uday < pday);
 }
 
 constexpr int16_t cyue_to_nian(int32_t cyue) noexcept {
-    int32_t bfit = data::YN_COEF[1] * cyue + data::YN_COEF[2];
-    int32_t pred = data::YN_COEF[0] + (bfit >> data::YN_BITS);
+    int32_t bfit = trim::YN_COEF[1] * cyue + trim::YN_COEF[2];
+    int32_t pred = trim::YN_COEF[0] + (bfit >> trim::YN_BITS);
     int32_t pyue = nian_to_cyue(pred);
     return pred - (cyue < pyue);
 }
 
+namespace _tab { // UR: uday_to_riqi, blocks of 16 days
+
+template <uint64_t N>
+struct index_u32 {
+    uint32_t recs[N];
+};
+
+// udays in [UR_MIN, UR_MAX], `nian`s in [NIAN_MIN, NIAN_MAX]
+inline constexpr int32_t UR_MIN =
+    cyue_to_uday(nian_to_cyue(NIAN_MIN));
+inline constexpr int32_t UR_MAX =
+    cyue_to_uday(nian_to_cyue(NIAN_MAX + 1)) - 1;
+
+// no `yue` shorter than a block, so 1 boundary at most
+inline constexpr int32_t UR_BITS = 4;
+inline constexpr uint64_t UR_SIZE = ((UR_MAX - UR_MIN) >> UR_BITS) + 1;
+
+static_assert(NIAN_MAX - NIAN_MIN < 512, "9 bits for `nian`");
+
+// record of bits: 0-8 `nian`, 9-13 `ryue`, 14-18 `tian` - 1 on block
+// start; 19-23 offset of next `yue`, 24-28 its `ryue`, 29 new `nian`
+template <uint64_t N>
+constexpr index_u32<N> ur_index() noexcept {
+    index_u32<N> idx = {};
+    int16_t nian = NIAN_MIN;
+    int8_t run = nian_to_run(nian);
+    int32_t cy01 = nian_to_cyue(nian), cynx = nian_to_cyue(nian + 1);
+    int32_t cyue = cy01;
+    int32_t ud01 = cyue_to_uday(cyue), udnx = cyue_to_uday(cyue + 1);
+    for (uint64_t i = 0; i < N; i++) {
+        int32_t ublk = UR_MIN + int32_t(i << UR_BITS);
+        while (ublk >= udnx) {
+            ud01 = udnx, udnx = cyue_to_uday(++cyue + 1);
+            if (cyue == cynx) {
+                cy01 = cynx, cynx = nian_to_cyue(++nian + 1);
+                run = nian_to_run(nian);
+            }
+        }
+        uint32_t ryue = nyue_to_ryue(cyue - cy01, run);
+        bool sui1 = cyue + 1 == cynx; // next `yue` in next `nian`
+        uint32_t ryu1 = sui1
+            ? nyue_to_ryue(0, nian_to_run(nian + 1))
+            : nyue_to_ryue(cyue + 1 - cy01, run);
+        int32_t skip = udnx - ublk; // clamped to block size
+        skip = (skip < (1 << UR_BITS)) ? skip : (1 << UR_BITS);
+        idx.recs[i] = uint32_t(nian - NIAN_MIN) | ryue << 9
+            | uint32_t(ublk - ud01) << 14 | uint32_t(skip) << 19
+            | ryu1 << 24 | uint32_t(sui1) << 29;
+    }
+    return idx;
+}
+
+template <uint64_t N = UR_SIZE>
+inline constexpr index_u32<N> UR_INDEX = ur_index<N>();
+
 constexpr riqi uday_to_riqi(int32_t uday) noexcept {
+    uint32_t iblk = uint32_t(uday - UR_MIN) >> UR_BITS;
+    uint32_t iday = uint32_t(uday - UR_MIN) & ((1 << UR_BITS) - 1);
+    uint32_t rec = UR_INDEX<>.recs[iblk];
+    int16_t nian = NIAN_MIN + (rec & 0x1ff);
+    uint32_t skip = (rec >> 19) & 0x1f;
+    if (iday < skip) {
+        int8_t tian = ((rec >> 14) & 0x1f) + iday + 1;
+        return riqi{nian, int8_t((rec >> 9) & 0x1f), tian};
+    }
+    nian += rec >> 29;
+    int8_t tian = iday - skip + 1;
+    return riqi{nian, int8_t((rec >> 24) & 0x1f), tian};
+}
+
+} // namespace _tab
+
+constexpr riqi uday_to_riqi(int32_t uday) noexcept {
+#if IW_NONGLI_UDAY_INDEX
+    return _tab::uday_to_riqi(uday);
+#else // IW_NONGLI_UDAY_INDEX
     int32_t cyue = uday_to_cyue(uday);
     int16_t nian = cyue_to_nian(cyue);
     int32_t cy01 = nian_to_cyue(nian);
@@ -135,6 +418,7 @@ constexpr riqi uday_to_riqi(int32_t uday) noexcept {
     int32_t ud01 = cyue_to_uday(cyue);
     int8_t tian = uday - ud01 + 1;
     return riqi{nian, ryue, tian};
+#endif // IW_NONGLI_UDAY_INDEX
 }
 
 constexpr riqi date_to_riqi(date locd) noexcept {
@@ -143,6 +427,9 @@ constexpr riqi date_to_riqi(date locd) noexcept {
 }
 
 constexpr int32_t riqi_to_uday(riqi rizi) noexcept {
+#if IW_NONGLI_DENSE
+    return _tab::riqi_to_uday(rizi);
+#else // IW_NONGLI_DENSE
     auto [nian, ryue, tian] = rizi;
     int8_t run = nian_to_run(nian);
     int8_t nyue = ryue_to_nyue(ryue, run);
@@ -150,6 +437,7 @@ constexpr int32_t riqi_to_uday(riqi rizi) noexcept {
     int32_t cyue = cy01 + nyue;
     int32_t ud01 = cyue_to_uday(cyue);
     return ud01 + tian - 1;
+#endif // IW_NONGLI_DENSE
 }
 
 constexpr date riqi_to_date(riqi rizi) noexcept {
@@ -157,7 +445,49 @@ constexpr date riqi_to_date(riqi rizi) noexcept {
     return uday_to_date(uday);
 }
 
+namespace _tab { // NI: `nian` summaries, for steps
+
 constexpr riqi next_nian(riqi rizi, int16_t step) noexcept {
+    if (step == 0) {
+        return rizi;
+    }
+    auto [nian, ryue, tian] = rizi;
+    nian += step;
+    nian_info info = nian_to_info(nian);
+    if (ryue & 1 && ryue >> 1 != info.run) {
+        ryue &= ~1;
+    }
+    if (tian >= 30) {
+        int8_t nyue = ryue_to_nyue(ryue, info.run);
+        tian = nyue_to_ndays(info, nyue);
+    }
+    return riqi{nian, ryue, tian};
+}
+
+constexpr riqi next_cyue(riqi rizi, int32_t step) noexcept {
+    if (step == 0) {
+        return rizi;
+    }
+    auto [nian, ryue, tian] = rizi;
+    nian_info info = nian_to_info(nian);
+    int8_t nyue = ryue_to_nyue(ryue, info.run);
+    int32_t cyue = info.cy01 + nyue + step;
+    nian = cyue_to_nian(cyue);
+    info = nian_to_info(nian);
+    nyue = cyue - info.cy01;
+    ryue = nyue_to_ryue(nyue, info.run);
+    if (tian >= 30) {
+        tian = nyue_to_ndays(info, nyue);
+    }
+    return riqi{nian, ryue, tian};
+}
+
+} // namespace _tab
+
+constexpr riqi next_nian(riqi rizi, int16_t step) noexcept {
+#if IW_NONGLI_DENSE
+    return _tab::next_nian(rizi, step);
+#else // IW_NONGLI_DENSE
     if (step == 0) {
         return rizi;
     }
@@ -173,9 +503,13 @@ constexpr riqi next_nian(riqi rizi, int16_t step) noexcept {
         tian = days_in_cyue(cy01 + nyue);
     }
     return riqi{nian, ryue, tian};
+#endif // IW_NONGLI_DENSE
 }
 
 constexpr riqi next_cyue(riqi rizi, int32_t step) noexcept {
+#if IW_NONGLI_DENSE
+    return _tab::next_cyue(rizi, step);
+#else // IW_NONGLI_DENSE
     if (step == 0) {
         return rizi;
     }
@@ -193,6 +527,7 @@ constexpr riqi next_cyue(riqi rizi, int32_t step) noexcept {
         tian = days_in_cyue(cyue);
     }
     return riqi{nian, ryue, tian};
+#endif // IW_NONGLI_DENSE
 }
 
 constexpr riqi next_tian(riqi rizi, int32_t step) noexcept {
@@ -203,6 +538,313 @@ constexpr riqi next_tian(riqi rizi, int32_t step) noexcept {
     return uday_to_riqi(uday + step);
 }
 
+// `riqi` of the birthday in `nian` of one born on `birth`: p30 falls
+// back to p29 in short `yue`s, and `runyue` to the common one
+constexpr riqi shengri(riqi birth, int16_t nian) noexcept {
+    return next_nian(birth, int16_t(nian - birth.nian));
+}
+
+namespace _bat { // batch: locality across neighbouring items
+
+// `yue` spanning udays [`ud01`, `udnx`) in `nian`
+struct yue_memo {
+    int32_t ud01, udnx;
+    int32_t cyue, cynx; // `cyue`, p01 of next `nian`
+    int16_t nian;
+    int8_t run, nyue, ryue;
+};
+
+constexpr yue_memo cyue_to_memo(int32_t cyue) noexcept {
+    int16_t nian = cyue_to_nian(cyue);
+    int32_t cy01 = nian_to_cyue(nian);
+    int32_t cynx = nian_to_cyue(nian + 1);
+    int8_t run = nian_to_run(nian);
+    int8_t nyue = cyue - cy01;
+    int8_t ryue = nyue_to_ryue(nyue, run);
+    int32_t ud01 = cyue_to_uday(cyue);
+    int32_t udnx = cyue_to_uday(cyue + 1);
+    return yue_memo{ud01, udnx, cyue, cynx, nian, run, nyue, ryue};
+}
+
+// one `cyue_to_uday` per `yue`, and refits per `nian`
+constexpr yue_memo next_memo(yue_memo memo) noexcept {
+    auto [_, ud01, cyue, cynx, nian, run, nyue, ryue] = memo;
+    if (++cyue == cynx) {
+        return cyue_to_memo(cyue);
+    }
+    ryue = nyue_to_ryue(++nyue, run);
+    int32_t udnx = cyue_to_uday(cyue + 1);
+    return yue_memo{ud01, udnx, cyue, cynx, nian, run, nyue, ryue};
+}
+
+constexpr yue_memo uday_to_memo(int32_t uday, yue_memo memo) noexcept {
+    if (uday >= memo.udnx) {
+        memo = next_memo(memo);
+        if (uday < memo.udnx) {
+            return memo;
+        }
+    }
+    return cyue_to_memo(uday_to_cyue(uday));
+}
+
+// first uday of (`nian`, `ryue`)
+struct riqi_memo {
+    int32_t cy01, ud01;
+    int16_t nian;
+    int8_t run, ryue;
+};
+
+constexpr riqi_memo nian_to_memo(int16_t nian) noexcept {
+    int32_t cy01 = nian_to_cyue(nian);
+    int8_t run = nian_to_run(nian);
+    return riqi_memo{cy01, 0, nian, run, 0};
+}
+
+constexpr riqi_memo riqi_to_memo(riqi rizi, riqi_memo memo) noexcept {
+    auto [nian, ryue, _] = rizi;
+    if (nian != memo.nian) {
+        memo = nian_to_memo(nian);
+    }
+    int8_t nyue = ryue_to_nyue(ryue, memo.run);
+    memo.ud01 = cyue_to_uday(memo.cy01 + nyue);
+    memo.ryue = ryue;
+    return memo;
+}
+
+} // namespace _bat
+
+namespace batch { // arrays in, arrays out
+
+// faster for sorted or clustered udays
+constexpr void uday_to_riqi(
+    const int32_t *udays, riqi *rizis, uint64_t num
+) noexcept {
+    if (num == 0) {
+        return;
+    }
+    int32_t cyue = iw17::uday_to_cyue(udays[0]);
+    _bat::yue_memo memo = _bat::cyue_to_memo(cyue);
+    for (uint64_t i = 0; i < num; i++) {
+        int32_t uday = udays[i];
+        if (uday < memo.ud01 || uday >= memo.udnx) {
+            memo = _bat::uday_to_memo(uday, memo);
+        }
+        int8_t tian = uday - memo.ud01 + 1;
+        rizis[i] = riqi{memo.nian, memo.ryue, tian};
+    }
+}
+
+// faster for sorted or clustered `riqi`s
+constexpr void riqi_to_uday(
+    const riqi *rizis, int32_t *udays, uint64_t num
+) noexcept {
+    if (num == 0) {
+        return;
+    }
+    _bat::riqi_memo memo = _bat::nian_to_memo(rizis[0].nian);
+    for (uint64_t i = 0; i < num; i++) {
+        auto [nian, ryue, tian] = rizis[i];
+        if (nian != memo.nian || ryue != memo.ryue) {
+            memo = _bat::riqi_to_memo(rizis[i], memo);
+        }
+        udays[i] = memo.ud01 + tian - 1;
+    }
+}
+
+} // namespace batch
+
+namespace _fit { // YD: consecutive `cyue`s
+
+// fittings stepped by their slopes, residuals read as a stream
+constexpr void cyue_to_uday(
+    int32_t cyue, int32_t *udays, uint64_t num
+) noexcept {
+    int64_t plin = trim::YD_COEF[0] * cyue + trim::YD_COEF[1];
+    int64_t bfit = trim::YD_COEF[2] * cyue + trim::YD_COEF[3];
+    auto [isub, ibit] = math::cdivmod<uint32_t>(cyue - CYUE_MIN, 4);
+    auto [iarr, iloc] = math::cdivmod<uint32_t>(isub, trim::YD_PAGE);
+    for (uint64_t i = 0; i < num; i++) {
+        if (iloc == trim::YD_PAGE) { // next page, only if read
+            iarr += 1, iloc = 0;
+        }
+        int32_t resd = (trim::YD_ARRD[iarr][iloc] >> (2 * ibit)) & 0b0011;
+        udays[i] = plin + (bfit >> trim::YD_BITS) + resd;
+        plin += trim::YD_COEF[0], bfit += trim::YD_COEF[2];
+        iloc += (ibit == 3), ibit = (ibit + 1) & 3;
+    }
+}
+
+} // namespace _fit
+
+namespace batch { // consecutive keys into arrays
+
+// `cyue_to_uday` of `cyue`s in [`cyue`, `cyue + num`)
+constexpr void cyue_to_uday(
+    int32_t cyue, int32_t *udays, uint64_t num
+) noexcept {
+#if IW_NONGLI_DENSE
+    const int32_t *vals = _tab::YD_DENSE<>.vals + (cyue - CYUE_MIN);
+    for (uint64_t i = 0; i < num; i++) {
+        udays[i] = vals[i];
+    }
+#else // IW_NONGLI_DENSE
+    _fit::cyue_to_uday(cyue, udays, num);
+#endif // IW_NONGLI_DENSE
+}
+
+// first udays of `yue`s starting in [`from`, `to`), `num` at most;
+// returns how many start there, the first `cyue` of them being
+// `uday_to_cyue(from - 1) + 1` within limits
+constexpr uint64_t yues_between(
+    int32_t from, int32_t to, int32_t *udays, uint64_t num
+) noexcept {
+    const int32_t ud_min = iw17::cyue_to_uday(CYUE_MIN);
+    const int32_t ud_end = iw17::cyue_to_uday(CYUE_MAX + 1);
+    if (from >= to || to <= ud_min || from > ud_end) {
+        return 0;
+    }
+    int32_t cy01 = (from <= ud_min) ? CYUE_MIN
+        : iw17::uday_to_cyue(from - 1) + 1;
+    int32_t cyed = (to > ud_end) ? CYUE_MAX + 1
+        : iw17::uday_to_cyue(to - 1);
+    uint64_t count = (cyed < cy01) ? 0 : uint64_t(cyed + 1 - cy01);
+    batch::cyue_to_uday(cy01, udays, (count < num) ? count : num);
+    return count;
+}
+
+} // namespace batch
+
+namespace _tab { // NI: birthdays by `nian` summaries
+
+// uday of `shengri(birth, nian)`, `info` being that of `nian`
+constexpr int32_t shengri(riqi birth, nian_info info) noexcept {
+    auto [_, ryue, tian] = birth;
+    if (ryue & 1 && ryue >> 1 != info.run) {
+        ryue &= ~1;
+    }
+    int8_t nyue = ryue_to_nyue(ryue, info.run);
+    int8_t ndays = nyue_to_ndays(info, nyue);
+    tian = (tian < ndays) ? tian : ndays;
+    return info.ud01 + nyue_to_days(info, nyue) + tian - 1;
+}
+
+// first date of a `yue`, with days of months it may reach
+struct yue_date {
+    date d01;
+    int8_t left; // days after `d01` in its month
+    int8_t next; // days in the month after
+};
+
+struct nian_dates {
+    yue_date yues[13];
+    uint16_t mask;
+    int8_t run;
+};
+
+// `nian`s dated at a time by batch `shengri`, 1312 bytes on stack
+inline constexpr int32_t ND_WIN = 16;
+
+constexpr nian_dates nian_to_dates(int16_t nian) noexcept {
+    nian_info info = nian_to_info(nian);
+    nian_dates dates = {{}, info.mask, info.run};
+    int8_t nyues = 12 + (info.run != 13);
+    for (int8_t nyue = 0; nyue < nyues; nyue++) {
+        int32_t uday = info.ud01 + nyue_to_days(info, nyue);
+        date d01 = uday_to_date(uday);
+        auto [y, m, _] = d01;
+        int16_t y1 = y + (m == 12), y2 = y + (m >= 11);
+        int8_t m1 = m % 12 + 1, m2 = (m + 1) % 12 + 1;
+        int32_t ud1 = date_to_uday(date{y1, m1, 1});
+        int32_t ud2 = date_to_uday(date{y2, m2, 1});
+        dates.yues[nyue] = {d01, int8_t(ud1 - uday - 1), int8_t(ud2 - ud1)};
+    }
+    return dates;
+}
+
+// date of `shengri(birth, nian)`, `dates` being those of `nian`
+constexpr date shengri(riqi birth, const nian_dates &dates) noexcept {
+    auto [_, ryue, tian] = birth;
+    if (ryue & 1 && ryue >> 1 != dates.run) {
+        ryue &= ~1;
+    }
+    int8_t nyue = ryue_to_nyue(ryue, dates.run);
+    int8_t ndays = 29 + ((dates.mask >> nyue) & 1);
+    int8_t past = ((tian < ndays) ? tian : ndays) - 1;
+    auto [d01, left, next] = dates.yues[nyue];
+    auto [y, m, d] = d01;
+    if (past <= left) {
+        return date{y, m, int8_t(d + past)};
+    }
+    past -= left + 1;
+    if ((m += 1) > 12) {
+        y += 1, m = 1;
+    }
+    if (past >= next) { // from January 31st over February
+        past -= next, m += 1;
+    }
+    return date{y, m, int8_t(past + 1)};
+}
+
+} // namespace _tab
+
+namespace batch { // consecutive keys into arrays
+
+// dates of `shengri` in `nian`s [`nian`, `nian + num`), only for
+// `nian`s in [NIAN_MIN, NIAN_MAX], others `date{}`
+constexpr void shengri(
+    riqi birth, int16_t nian, date *dates, uint64_t num
+) noexcept {
+    for (uint64_t i = 0; i < num; i++) {
+        int64_t ni = nian + int64_t(i);
+        if (ni < NIAN_MIN || ni > NIAN_MAX) {
+            dates[i] = date{};
+            continue;
+        }
+        _tab::nian_info info = _tab::nian_to_info(int16_t(ni));
+        dates[i] = uday_to_date(_tab::shengri(birth, info));
+    }
+}
+
+// dates of `shengri` in `nian`s [`nian`, `nian + span`) for each of
+// `births`, `span` in a row; `yue`s dated once for all births; only
+// for `nian`s in [NIAN_MIN, NIAN_MAX], others `date{}`
+constexpr void shengri(
+    const riqi *births, date *dates, uint64_t num,
+    int16_t nian, int16_t span
+) noexcept {
+    if (span <= 0) {
+        return;
+    }
+    // columns [`beg`, `end`) in range, others `date{}`
+    int32_t beg = (nian < NIAN_MIN) ? NIAN_MIN - nian : 0;
+    int32_t end = (nian + span > NIAN_MAX + 1)
+        ? NIAN_MAX + 1 - nian : span;
+    for (uint64_t i = 0; i < num; i++) {
+        date *row = dates + i * span;
+        for (int32_t k = 0; k < span; k++) {
+            if (k < beg || k >= end) {
+                row[k] = date{};
+            }
+        }
+    }
+    // `ND_WIN` columns at a time, each row visited once per window
+    _tab::nian_dates table[_tab::ND_WIN] = {};
+    for (int32_t k0 = beg; k0 < end; k0 += _tab::ND_WIN) {
+        int32_t k1 = (end - k0 > _tab::ND_WIN) ? k0 + _tab::ND_WIN : end;
+        for (int32_t k = k0; k < k1; k++) {
+            table[k - k0] = _tab::nian_to_dates(int16_t(nian + k));
+        }
+        for (uint64_t i = 0; i < num; i++) {
+            date *row = dates + i * span;
+            for (int32_t k = k0; k < k1; k++) {
+                row[k] = _tab::shengri(births[i], table[k - k0]);
+            }
+        }
+    }
+}
+
+} // namespace batch
+
 enum class jieqi: int8_t {
     dongzhi,    xiaohan,    dahan,
     lichun,     yushui,     jingzhe,
@@ -233,23 +875,23 @@ namespace _fit { // JS: cjie_to_usec
 
 constexpr int64_t js_pred(shihou shi) noexcept {
     auto [sui, jie] = shi;
-    int64_t plin = data::JS_CLIN[0] * sui + data::JS_CLIN[1];
-    const auto &coef = data::JS_COEF[int8_t(jie)];
+    int64_t plin = trim::JS_CLIN[0] * sui + trim::JS_CLIN[1];
+    const auto &coef = trim::JS_COEF[int8_t(jie)];
     int64_t pfit = coef[0];
     // about 1/3 faster than for-loop
-    pfit = (pfit * sui >> data::JS_BITS) + coef[1];
-    pfit = (pfit * sui >> data::JS_BITS) + coef[2];
-    pfit = (pfit * sui >> data::JS_BITS) + coef[3];
-    pfit = (pfit * sui >> data::JS_BITS) + coef[4];
-    pfit = (pfit * sui >> data::JS_BITS) + coef[5];
-    pfit = (pfit * sui >> data::JS_BITS) + coef[6];
+    pfit = (pfit * sui >> trim::JS_BITS) + coef[1];
+    pfit = (pfit * sui >> trim::JS_BITS) + coef[2];
+    pfit = (pfit * sui >> trim::JS_BITS) + coef[3];
+    pfit = (pfit * sui >> trim::JS_BITS) + coef[4];
+    pfit = (pfit * sui >> trim::JS_BITS) + coef[5];
+    pfit = (pfit * sui >> trim::JS_BITS) + coef[6];
     return plin + pfit;
 }
 
 constexpr int64_t js_ress(int32_t cjie) noexcept {
     int32_t ijie = cjie - CJIE_MIN, isub = ijie + (ijie >> 1);
-    auto [iarr, iloc] = math::cdivmod<uint32_t>(isub, data::JS_PAGE);
-    const uint8_t *arrs = data::JS_ARRS[iarr];
+    auto [iarr, iloc] = math::cdivmod<uint32_t>(isub, trim::JS_PAGE);
+    const uint8_t *arrs = trim::JS_ARRS[iarr];
     // 0x12, 0x34, 0x56 -> 0x412, 0x563
     uint32_t pair = (uint32_t(arrs[iloc + 1]) << 8) | arrs[iloc];
     return (cjie & 1) ? (pair >> 4) : (pair & 0x0fff);
@@ -281,13 +923,59 @@ constexpr dati cjie_to_dati(int32_t cjie) noexcept {
     return usec_to_dati(usec, tzinfo::east_0800);
 }
 
+namespace _fit { // SJ: usec_to_cjie
+
+// `cjie` of `usec`, or the next one
+constexpr int32_t sj_pred(int64_t usec) noexcept {
+    int32_t pbit = trim::SJ_COEF[1] * usec >> trim::SJ_BITS;
+    int32_t plin = (pbit + trim::SJ_COEF[2]) >> trim::SJ_BITS;
+    return plin + trim::SJ_COEF[0];
+}
+
+} // namespace _fit
+
+namespace _tab { // JS: boundaries of all `jie`s, sorted
+
+template <uint64_t N>
+struct dense_i64 {
+    int64_t vals[N];
+};
+
+// `cjie`s in [CJIE_MIN, CJIE_MAX], as residuals
+inline constexpr uint64_t JS_SIZE = CJIE_MAX + 1 - CJIE_MIN;
+
+template <uint64_t N>
+constexpr dense_i64<N> js_dense() noexcept {
+    dense_i64<N> tab = {};
+    for (uint64_t i = 0; i < N; i++) {
+        tab.vals[i] = cjie_to_usec(CJIE_MIN + int32_t(i));
+    }
+    return tab;
+}
+
+template <uint64_t N = JS_SIZE>
+inline constexpr dense_i64<N> JS_DENSE = js_dense<N>();
+
+// the fitting as interpolation, so a single probe suffices
+constexpr int32_t usec_to_cjie(int64_t usec) noexcept {
+    int32_t pred = _fit::sj_pred(usec);
+    uint32_t ipred = uint32_t(pred - CJIE_MIN);
+    int64_t psec = (ipred < JS_SIZE)
+        ? JS_DENSE<>.vals[ipred] : cjie_to_usec(pred);
+    return pred - (usec < psec);
+}
+
+} // namespace _tab
+
 constexpr int32_t usec_to_cjie(int64_t usec) noexcept {
-    int32_t pbit = data::SJ_COEF[1] * usec >> data::SJ_BITS;
-    int32_t plin = (pbit + data::SJ_COEF[2]) >> data::SJ_BITS;
-    int32_t pred = plin + data::SJ_COEF[0];
+#if IW_NONGLI_JIE_INDEX
+    return _tab::usec_to_cjie(usec);
+#else // IW_NONGLI_JIE_INDEX
+    int32_t pred = _fit::sj_pred(usec);
     shihou pshi = cjie_to_shihou(pred);
     int64_t psec = shihou_to_usec(pshi);
     return pred - (usec < psec);
+#endif // IW_NONGLI_JIE_INDEX
 }
 
 constexpr int32_t dati_to_cjie(dati zond) noexcept {
@@ -405,24 +1093,89 @@ constexpr ganzhi bshi_to_ganzhi(int64_t bshi) noexcept {
     return ganzhi(sord);
 }
 
+namespace _bat { // days counted from `jie` boundaries
+
+// first `geng` day on or after the day of `usec`; `tiangan` of
+// uday 0 being `xin`, `geng` days are those of -1 modulo 10
+constexpr int32_t usec_to_geng(int64_t usec) noexcept {
+    int32_t uday = usec_to_uday(usec);
+    return uday + 9 - math::pymod<int32_t>(uday, 10);
+}
+
+} // namespace _bat
+
 constexpr int32_t sui_to_toufu(int16_t sui) noexcept {
     int64_t usxz = shihou_to_usec({sui, jieqi::xiazhi});
-    int32_t udxz = usec_to_uday(usxz);
-    tiangan tgxz = ganzhi_to_tiangan(uday_to_ganzhi(udxz));
-    int8_t diff = int8_t(tiangan::geng) - int8_t(tgxz);
-    int8_t dtxz = math::pymod<int8_t>(diff, 10);
-    return udxz + dtxz + 20;
+    return _bat::usec_to_geng(usxz) + 20;
 }
 
 constexpr int32_t sui_to_sanfu(int16_t sui) noexcept {
     int64_t uslq = shihou_to_usec({sui, jieqi::liqiu});
-    int32_t udlq = usec_to_uday(uslq);
-    tiangan tglq = ganzhi_to_tiangan(uday_to_ganzhi(udlq));
-    int8_t diff = int8_t(tiangan::geng) - int8_t(tglq);
-    int8_t dtlq = math::pymod<int8_t>(diff, 10);
-    return udlq + dtlq;
+    return _bat::usec_to_geng(uslq);
 }
 
+struct futian { // first udays of `fu`s, and the day after
+    int32_t toufu, erfu, sanfu, udnx;
+};
+
+struct shujiu { // first udays of 9 `jiu`s, and the day after
+    int32_t jius[10];
+};
+
+namespace _bat { // days counted from `jie` boundaries
+
+constexpr futian make_futian(int64_t usxz, int64_t uslq) noexcept {
+    int32_t toufu = usec_to_geng(usxz) + 20;
+    int32_t sanfu = usec_to_geng(uslq);
+    return futian{toufu, toufu + 10, sanfu, sanfu + 10};
+}
+
+constexpr shujiu make_shujiu(int64_t usdz) noexcept {
+    int32_t uddz = usec_to_uday(usdz);
+    shujiu shu = {};
+    for (int8_t jiu = 0; jiu <= 9; jiu++) {
+        shu.jius[jiu] = uddz + 9 * jiu;
+    }
+    return shu;
+}
+
+} // namespace _bat
+
+// `toufu`, `erfu` and `sanfu` of `sui`, `erfu` of 10 or 20 days
+constexpr futian sui_to_futian(int16_t sui) noexcept {
+    int64_t usxz = shihou_to_usec({sui, jieqi::xiazhi});
+    int64_t uslq = shihou_to_usec({sui, jieqi::liqiu});
+    return _bat::make_futian(usxz, uslq);
+}
+
+// `jiu`s from `dongzhi` day, which starts `sui`
+constexpr shujiu sui_to_shujiu(int16_t sui) noexcept {
+    int64_t usdz = shihou_to_usec({sui, jieqi::dongzhi});
+    return _bat::make_shujiu(usdz);
+}
+
+namespace batch { // consecutive keys into arrays
+
+// `sui_to_futian` of `sui`s in [`sui`, `sui + num`)
+constexpr void sui_to_futian(
+    int16_t sui, futian *futs, uint64_t num
+) noexcept {
+    for (uint64_t i = 0; i < num; i++) {
+        futs[i] = iw17::sui_to_futian(sui + int16_t(i));
+    }
+}
+
+// `sui_to_shujiu` of `sui`s in [`sui`, `sui + num`)
+constexpr void sui_to_shujiu(
+    int16_t sui, shujiu *shus, uint64_t num
+) noexcept {
+    for (uint64_t i = 0; i < num; i++) {
+        shus[i] = iw17::sui_to_shujiu(sui + int16_t(i));
+    }
+}
+
+} // namespace batch
+
 struct bazi { // 4 `zhu`s: `nian`, `yue`, `ri`, `shi`
     ganzhi zhu[4];
 };
@@ -431,12 +1184,29 @@ namespace _rst { // real solar time: longitude bias and EoT
 
 using iw17::math::fix64;
 
+#if IW_NONGLI_LUT_TRIG // errors within 4e-8, far below a second
+namespace trig = math::_lut;
+#else // IW_NONGLI_LUT_TRIG
+namespace trig = math;
+#endif // IW_NONGLI_LUT_TRIG
+
+// `cjie` spanning usecs [`last`, `next`)
+struct jie_span {
+    int64_t last, next;
+    int32_t cjie;
+};
+
+constexpr jie_span cjie_to_span(int32_t cjie) noexcept {
+    int64_t last = cjie_to_usec(cjie);
+    int64_t next = cjie_to_usec(cjie + 1);
+    return jie_span{last, next, cjie};
+}
+
 // true longitude (in 1/16 round) of the Sun on the ecliptic
-constexpr fix64 usec_to_q4tl(int64_t usec, int32_t cjie) noexcept {
+constexpr fix64 usec_to_q4tl(int64_t usec, jie_span span) noexcept {
     constexpr int32_t CF = int32_t(jieqi::chunfen);
+    auto [last, next, cjie] = span;
     int32_t ljie = math::pymod<int32_t>(cjie - CF, 24);
-    int64_t last = cjie_to_usec(cjie);
-    int64_t next = cjie_to_usec(cjie + 1);
     int64_t past = usec - last;
     int64_t jdur = next - last;
     int64_t pscf = ljie * jdur + past; // since `chunfen`
@@ -486,21 +1256,21 @@ constexpr fix64 ucen_to_oble(fix64 ucen) noexcept {
 }
 
 // equation of time (EoT) in second
-constexpr fix64 usec_to_eots(int64_t usec, int32_t cjie) noexcept {
+constexpr fix64 usec_to_eots(int64_t usec, jie_span span) noexcept {
     using namespace math::literal;
     fix64 ucen = usec_to_ucen(usec); // centuries since J2000
     fix64 ecco = ucen_to_ecco(ucen); // eccentricity of orbit
     fix64 q2ma = usec_to_q2ma(usec); // 2x mean anomaly
-    fix64 s2ma = math::sinq(q2ma); // sin of 2x mano
-    fix64 s1ma = math::sinq(q2ma >> 1); // sin of mano
+    fix64 s2ma = trig::sinq(q2ma); // sin of 2x mano
+    fix64 s1ma = trig::sinq(q2ma >> 1); // sin of mano
     fix64 hecc = math::fast_mul(ecco, s2ma); // HA bias from ecc
     hecc = -hecc - (hecc >> 2);
     hecc = math::fast_mul(ecco, hecc - 2 * s1ma);
     fix64 oble = ucen_to_oble(ucen); // obliquity of ecliptic
-    fix64 q4tl = usec_to_q4tl(usec, cjie); // 4x true longitude
-    fix64 veso = 1_fix - math::cosq(oble); // 1 - cos of obl
-    fix64 s4tl = math::sinq(q4tl); // sin of 4x true lon
-    fix64 s2tl = math::sinq(q4tl >> 1); // sin of 2x true lon
+    fix64 q4tl = usec_to_q4tl(usec, span); // 4x true longitude
+    fix64 veso = 1_fix - trig::cosq(oble); // 1 - cos of obl
+    fix64 s4tl = trig::sinq(q4tl); // sin of 4x true lon
+    fix64 s2tl = trig::sinq(q4tl >> 1); // sin of 2x true lon
     fix64 hobl = (s2tl - (s4tl >> 1)) >> 1; // HA bias from obl
     hobl = math::fast_mul(hobl, veso) + (s2tl >> 1);
     hobl = math::fast_mul(hobl, veso);
@@ -509,14 +1279,8 @@ constexpr fix64 usec_to_eots(int64_t usec, int32_t cjie) noexcept {
     return 13751 * hsum + math::fast_mul(HATF, hsum);
 }
 
-} // namespace _rst: real solar time
-
-constexpr bazi usec_to_bazi(int64_t usec, double lon) noexcept {
-    int32_t cjie = usec_to_cjie(usec);
-    math::fix64 bias_lon = 240 * math::make_fix64(lon);
-    math::fix64 bias_eot = _rst::usec_to_eots(usec, cjie);
-    math::fix64 bias_rst = bias_lon + bias_eot;
-    int64_t rsec = usec + math::safe_int(bias_rst);
+// `bazi` of real solar time `rsec` in `cjie`
+constexpr bazi rsec_to_bazi(int64_t rsec, int32_t cjie) noexcept {
     int64_t bshi = math::pydiv<int64_t>(rsec + 3600, 7200);
     int32_t bday = math::pydiv<int64_t>(rsec, 86400);
     int32_t byue = (cjie - 3) >> 1;
@@ -528,11 +1292,291 @@ constexpr bazi usec_to_bazi(int64_t usec, double lon) noexcept {
     return bazi{nzhu, yzhu, rzhu, szhu};
 }
 
+// real solar time of `usec` in `span`, at longitude `lon`
+constexpr int64_t span_to_rsec(
+    int64_t usec, jie_span span, double lon
+) noexcept {
+    fix64 bias_lon = 240 * math::make_fix64(lon);
+    fix64 bias_eot = usec_to_eots(usec, span);
+    fix64 bias_rst = bias_lon + bias_eot;
+    return usec + math::safe_int(bias_rst);
+}
+
+// `bazi` of `usec` in `span`, at longitude `lon`
+constexpr bazi span_to_bazi(
+    int64_t usec, jie_span span, double lon
+) noexcept {
+    int64_t rsec = span_to_rsec(usec, span, lon);
+    return rsec_to_bazi(rsec, span.cjie);
+}
+
+} // namespace _rst: real solar time
+
+namespace _tab { // EO: `usec_to_eots` sampled daily, linear in between
+
+// EoT in 1/65536 second at 00:00 in UTC+8, over [MIN, MAX + 1]
+inline constexpr int32_t EO_MIN = usec_to_uday(cjie_to_usec(CJIE_MIN));
+inline constexpr int32_t EO_MAX = usec_to_uday(cjie_to_usec(CJIE_MAX));
+inline constexpr uint64_t EO_SIZE = EO_MAX + 2 - EO_MIN;
+inline constexpr int64_t EO_BITS = 16;
+
+// EoT off by 0.13 second at most, `rsec` by 1 second at most
+inline constexpr int64_t EO_MARGIN = 1;
+
+struct knots_i32 {
+    int32_t vals[EO_SIZE];
+};
+
+// too many for constant evaluation, thus filled on first use
+inline const knots_i32 &eo_knots() noexcept {
+    constexpr int64_t SHIFT = math::fix::FBITS - EO_BITS;
+    static knots_i32 tab;
+    static const bool done = [] {
+        for (uint64_t i = 0; i < EO_SIZE; i++) {
+            int64_t usec = uday_to_usec(EO_MIN + int32_t(i));
+            int32_t cjie = usec_to_cjie(usec); // extended at both ends
+            cjie = (cjie < CJIE_MIN) ? CJIE_MIN : cjie;
+            cjie = (cjie >= CJIE_MAX) ? CJIE_MAX - 1 : cjie;
+            _rst::jie_span span = _rst::cjie_to_span(cjie);
+            math::fix64 eots = _rst::usec_to_eots(usec, span);
+            int64_t half = int64_t(1) << (SHIFT - 1);
+            tab.vals[i] = (math::pour_int64(eots) + half) >> SHIFT;
+        }
+        return true;
+    }();
+    (void)done;
+    return tab;
+}
+
+// only for usecs in [cjie_to_usec(CJIE_MIN), cjie_to_usec(CJIE_MAX))
+inline math::fix64 usec_to_eots(int64_t usec) noexcept {
+    const knots_i32 &knots = eo_knots();
+    int64_t past = usec - uday_to_usec(EO_MIN);
+    auto [iday, secs] = math::pydivmod<int64_t>(past, 86400);
+    int64_t last = knots.vals[iday];
+    int64_t next = knots.vals[iday + 1];
+    int64_t eots = last * 86400 + (next - last) * secs;
+    constexpr int64_t SHIFT = math::fix::FBITS - EO_BITS;
+    return math::fill_fix64(eots * (int64_t(1) << SHIFT) / 86400);
+}
+
+// exact if `rsec` may cross an hour, where `shi` and `ri` change
+inline bazi usec_to_bazi(int64_t usec, double lon) noexcept {
+    int32_t cjie = usec_to_cjie(usec);
+    if (cjie >= CJIE_MIN && cjie < CJIE_MAX) {
+        math::fix64 bias_lon = 240 * math::make_fix64(lon);
+        math::fix64 bias_rst = bias_lon + _tab::usec_to_eots(usec);
+        int64_t rsec = usec + math::safe_int(bias_rst);
+        int64_t hsec = math::pymod<int64_t>(rsec, 3600);
+        if (hsec > EO_MARGIN && hsec < 3600 - EO_MARGIN) {
+            return _rst::rsec_to_bazi(rsec, cjie);
+        }
+    }
+    _rst::jie_span span = _rst::cjie_to_span(cjie);
+    return _rst::span_to_bazi(usec, span, lon);
+}
+
+// validation: cached against exact, over `usec`s whose real solar
+// times are within a few seconds of each hour of `uday`
+inline bool check_bazi(int32_t uday, double lon) noexcept {
+    constexpr int64_t NEAR = EO_MARGIN + 2;
+    for (int64_t hour = 0; hour < 24; hour++) {
+        int64_t usec = uday_to_usec(uday) + 3600 * hour;
+        _rst::jie_span span = _rst::cjie_to_span(usec_to_cjie(usec));
+        usec -= _rst::span_to_rsec(usec, span, lon) - usec;
+        for (int64_t inst = usec - NEAR; inst <= usec + NEAR; inst++) {
+            span = _rst::cjie_to_span(usec_to_cjie(inst));
+            bazi real = _rst::span_to_bazi(inst, span, lon);
+            bazi fast = _tab::usec_to_bazi(inst, lon);
+            if (prestd::uint_cast(fast) != prestd::uint_cast(real)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace _tab
+
+constexpr bazi usec_to_bazi(int64_t usec, double lon) noexcept {
+#if IW_NONGLI_EOT_CACHE // exact in constant evaluation
+    if (!prestd::is_constant_evaluated()) {
+        return _tab::usec_to_bazi(usec, lon);
+    }
+#endif // IW_NONGLI_EOT_CACHE
+    int32_t cjie = usec_to_cjie(usec);
+    _rst::jie_span span = _rst::cjie_to_span(cjie);
+    return _rst::span_to_bazi(usec, span, lon);
+}
+
 constexpr bazi dati_to_bazi(dati zond, double lon) noexcept {
     int64_t usec = dati_to_usec(zond);
     return usec_to_bazi(usec, lon);
 }
 
+namespace _bat { // batch: `jie`s across neighbouring usecs
+
+// no `jie` after CJIE_MAX, treated as lasting forever; such spans
+// only for `shihou`, never for `bazi`
+constexpr _rst::jie_span cjie_to_memo(int32_t cjie) noexcept {
+    int64_t last = cjie_to_usec(cjie);
+    bool far = cjie >= CJIE_MAX;
+    int64_t next = far ? INT64_MAX : cjie_to_usec(cjie + 1);
+    return _rst::jie_span{last, next, cjie};
+}
+
+// one `cjie_to_usec` per `jie`, and refits on jumps
+constexpr _rst::jie_span usec_to_memo(
+    int64_t usec, _rst::jie_span span
+) noexcept {
+    if (usec >= span.next) {
+        span = _bat::cjie_to_memo(span.cjie + 1);
+        if (usec < span.next) {
+            return span;
+        }
+    }
+    return _bat::cjie_to_memo(usec_to_cjie(usec));
+}
+
+} // namespace _bat
+
+namespace batch { // arrays in, arrays out
+
+// faster for sorted or clustered usecs
+constexpr void usec_to_shihou(
+    const int64_t *usecs, shihou *shis, uint64_t num
+) noexcept {
+    if (num == 0) {
+        return;
+    }
+    int32_t cjie = usec_to_cjie(usecs[0]);
+    _rst::jie_span span = _bat::cjie_to_memo(cjie);
+    for (uint64_t i = 0; i < num; i++) {
+        int64_t usec = usecs[i];
+        if (usec < span.last || usec >= span.next) {
+            span = _bat::usec_to_memo(usec, span);
+        }
+        shis[i] = cjie_to_shihou(span.cjie);
+    }
+}
+
+// faster for sorted or clustered usecs; only for usecs in
+// [cjie_to_usec(CJIE_MIN), cjie_to_usec(CJIE_MAX)), others `bazi{}`
+constexpr void usec_to_bazi(
+    const int64_t *usecs, bazi *bazis, uint64_t num, double lon
+) noexcept {
+    const int64_t us_min = iw17::cjie_to_usec(CJIE_MIN);
+    const int64_t us_max = iw17::cjie_to_usec(CJIE_MAX);
+    _rst::jie_span span = _bat::cjie_to_memo(CJIE_MIN);
+    for (uint64_t i = 0; i < num; i++) {
+        int64_t usec = usecs[i];
+        if (usec < us_min || usec >= us_max) {
+            bazis[i] = bazi{};
+            continue;
+        }
+        if (usec < span.last || usec >= span.next) {
+            span = _bat::usec_to_memo(usec, span);
+        }
+        bazis[i] = _rst::span_to_bazi(usec, span, lon);
+    }
+}
+
+// faster for sorted or clustered usecs, in UTC+8
+constexpr void usec_to_riqi(
+    const int64_t *usecs, riqi *rizis, uint64_t num
+) noexcept {
+    if (num == 0) {
+        return;
+    }
+    int32_t cyue = uday_to_cyue(usec_to_uday(usecs[0]));
+    _bat::yue_memo memo = _bat::cyue_to_memo(cyue);
+    for (uint64_t i = 0; i < num; i++) {
+        int32_t uday = usec_to_uday(usecs[i]);
+        if (uday < memo.ud01 || uday >= memo.udnx) {
+            memo = _bat::uday_to_memo(uday, memo);
+        }
+        int8_t tian = uday - memo.ud01 + 1;
+        rizis[i] = riqi{memo.nian, memo.ryue, tian};
+    }
+}
+
+} // namespace batch
+
+namespace _fit { // JS: consecutive `cjie`s
+
+// `sui`, `jie`, `plin` and residuals stepped, Horner per `jie`
+constexpr void cjie_to_usec(
+    int32_t cjie, int64_t *usecs, uint64_t num
+) noexcept {
+    auto [sui, jie] = cjie_to_shihou(cjie);
+    int8_t ijie = int8_t(jie);
+    int64_t plin = trim::JS_CLIN[0] * sui + trim::JS_CLIN[1];
+    uint32_t ioff = cjie - CJIE_MIN, isub = ioff + (ioff >> 1);
+    auto [iarr, iloc] = math::cdivmod<uint32_t>(isub, trim::JS_PAGE);
+    bool odd = cjie & 1;
+    for (uint64_t i = 0; i < num; i++) {
+        if (iloc == trim::JS_PAGE) { // pages hold whole pairs
+            iarr += 1, iloc = 0;
+        }
+        const auto &coef = trim::JS_COEF[ijie];
+        int64_t pfit = coef[0];
+        pfit = (pfit * sui >> trim::JS_BITS) + coef[1];
+        pfit = (pfit * sui >> trim::JS_BITS) + coef[2];
+        pfit = (pfit * sui >> trim::JS_BITS) + coef[3];
+        pfit = (pfit * sui >> trim::JS_BITS) + coef[4];
+        pfit = (pfit * sui >> trim::JS_BITS) + coef[5];
+        pfit = (pfit * sui >> trim::JS_BITS) + coef[6];
+        const uint8_t *arrs = trim::JS_ARRS[iarr] + iloc;
+        uint32_t pair = (uint32_t(arrs[1]) << 8) | arrs[0];
+        int64_t ress = odd ? (pair >> 4) : (pair & 0x0fff);
+        usecs[i] = plin + pfit + ress;
+        iloc += 1 + odd, odd = !odd;
+        if (++ijie == 24) {
+            ijie = 0, sui += 1, plin += trim::JS_CLIN[0];
+        }
+    }
+}
+
+} // namespace _fit
+
+namespace batch { // consecutive keys into arrays
+
+// `cjie_to_usec` of `cjie`s in [`cjie`, `cjie + num`)
+constexpr void cjie_to_usec(
+    int32_t cjie, int64_t *usecs, uint64_t num
+) noexcept {
+#if IW_NONGLI_JIE_INDEX
+    const int64_t *vals = _tab::JS_DENSE<>.vals + (cjie - CJIE_MIN);
+    for (uint64_t i = 0; i < num; i++) {
+        usecs[i] = vals[i];
+    }
+#else // IW_NONGLI_JIE_INDEX
+    _fit::cjie_to_usec(cjie, usecs, num);
+#endif // IW_NONGLI_JIE_INDEX
+}
+
+// usecs of `jie`s starting in [`from`, `to`), `num` at most;
+// returns how many start there, the first `cjie` of them being
+// `usec_to_cjie(from - 1) + 1` within limits
+constexpr uint64_t jies_between(
+    int64_t from, int64_t to, int64_t *usecs, uint64_t num
+) noexcept {
+    const int64_t us_min = iw17::cjie_to_usec(CJIE_MIN);
+    const int64_t us_max = iw17::cjie_to_usec(CJIE_MAX);
+    if (from >= to || to <= us_min || from > us_max) {
+        return 0;
+    }
+    int32_t cj01 = (from <= us_min) ? CJIE_MIN
+        : iw17::usec_to_cjie(from - 1) + 1;
+    int32_t cjed = (to > us_max) ? CJIE_MAX
+        : iw17::usec_to_cjie(to - 1);
+    uint64_t count = (cjed < cj01) ? 0 : uint64_t(cjed + 1 - cj01);
+    batch::cjie_to_usec(cj01, usecs, (count < num) ? count : num);
+    return count;
+}
+
+} // namespace batch
+
 } // namespace iw17
 
 #endif // IW_NONGLI_HPP
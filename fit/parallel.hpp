@@ -0,0 +1,184 @@
+#ifndef IW_PARALLEL_HPP
+#define IW_PARALLEL_HPP 20251016L
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// 1: chunks run by `std::execution::par`, instead of `pool` workers
+#ifndef IW_PARALLEL_STD
+#define IW_PARALLEL_STD 0
+#endif // IW_PARALLEL_STD
+
+#if IW_PARALLEL_STD
+#include <execution>
+#include <numeric>
+#endif // IW_PARALLEL_STD
+
+#include "nongli.hpp"
+
+namespace iw17::parallel {
+
+// items per chunk at least, to amortize dispatch
+inline constexpr uint64_t GRAIN = 16384;
+
+// chunks per thread at most, to balance uneven loads
+inline constexpr uint64_t SPLIT = 4;
+
+// persistent workers, splitting one job at a time into chunks;
+// concurrent `run`s take turns, and `run` must not be called from
+// within a job, nor be given a `func` that may throw
+struct pool {
+
+// `threads` in total, including the caller; 0 for all cores
+explicit pool(unsigned threads = 0) {
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    count = threads;
+#if !IW_PARALLEL_STD // no workers, threads by the library
+    for (unsigned i = 1; i < threads; i++) {
+        workers.emplace_back([this] { this->work(); });
+    }
+#endif // IW_PARALLEL_STD
+}
+
+pool(const pool &) = delete;
+
+pool &operator=(const pool &) = delete;
+
+~pool() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stop = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker: workers) {
+        worker.join();
+    }
+}
+
+unsigned size() const noexcept {
+    return count;
+}
+
+// chunks of `[0, num)` into `func(beg, end)`, then waits for all
+template <class Func>
+void run(uint64_t num, Func func) {
+    // a throw would leave workers unaccounted and `run` waiting
+    static_assert(std::is_nothrow_invocable_v<Func &, uint64_t, uint64_t>,
+        "`func` of `pool::run` must be noexcept");
+    uint64_t most = (num + GRAIN - 1) / GRAIN;
+    uint64_t nchk = std::min(most, SPLIT * this->size());
+    if (nchk <= 1) {
+        func(uint64_t(0), num);
+        return;
+    }
+#if IW_PARALLEL_STD
+    std::vector<uint64_t> ichks(nchk);
+    std::iota(ichks.begin(), ichks.end(), uint64_t(0));
+    std::for_each(std::execution::par, ichks.begin(), ichks.end(),
+        [&](uint64_t ichk) {
+            func(num * ichk / nchk, num * (ichk + 1) / nchk);
+        }
+    );
+#else // IW_PARALLEL_STD
+    std::lock_guard<std::mutex> turn(serial); // one job at a time
+    std::unique_lock<std::mutex> lock(mtx);
+    job = [&func](uint64_t beg, uint64_t end) { func(beg, end); };
+    total = num, chunks = nchk, left = workers.size();
+    next.store(0);
+    epoch += 1;
+    lock.unlock();
+    wake.notify_all();
+    this->drain();
+    lock.lock();
+    idle.wait(lock, [this] { return left == 0; });
+    job = nullptr;
+#endif // IW_PARALLEL_STD
+}
+
+private:
+
+std::vector<std::thread> workers;
+std::mutex serial, mtx;
+std::condition_variable wake, idle;
+std::function<void(uint64_t, uint64_t)> job;
+uint64_t total = 0, chunks = 0, epoch = 0, left = 0;
+std::atomic<uint64_t> next{0};
+unsigned count = 1;
+bool stop = false;
+
+// chunks claimed one by one, until none left
+void drain() {
+    for (uint64_t ichk; (ichk = next.fetch_add(1)) < chunks; ) {
+        job(total * ichk / chunks, total * (ichk + 1) / chunks);
+    }
+}
+
+// job fields untouched by `run` until all workers are done
+void work() {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        wake.wait(lock, [&] { return stop || epoch != seen; });
+        if (stop) {
+            return;
+        }
+        seen = epoch;
+        lock.unlock();
+        this->drain();
+        lock.lock();
+        if (--left == 0) {
+            idle.notify_one();
+        }
+    }
+}
+
+}; // struct pool
+
+// contiguous chunks, each with its own `batch` memo
+
+inline void usec_to_shihou(pool &exec,
+    const int64_t *usecs, shihou *shis, uint64_t num
+) {
+    exec.run(num, [=](uint64_t beg, uint64_t end) noexcept {
+        batch::usec_to_shihou(usecs + beg, shis + beg, end - beg);
+    });
+}
+
+// only in range of `batch::usec_to_bazi`, others `bazi{}`
+inline void usec_to_bazi(pool &exec,
+    const int64_t *usecs, bazi *bazis, uint64_t num, double lon
+) {
+    exec.run(num, [=](uint64_t beg, uint64_t end) noexcept {
+        batch::usec_to_bazi(usecs + beg, bazis + beg, end - beg, lon);
+    });
+}
+
+// in UTC+8
+inline void usec_to_riqi(pool &exec,
+    const int64_t *usecs, riqi *rizis, uint64_t num
+) {
+    exec.run(num, [=](uint64_t beg, uint64_t end) noexcept {
+        batch::usec_to_riqi(usecs + beg, rizis + beg, end - beg);
+    });
+}
+
+inline void uday_to_riqi(pool &exec,
+    const int32_t *udays, riqi *rizis, uint64_t num
+) {
+    exec.run(num, [=](uint64_t beg, uint64_t end) noexcept {
+        batch::uday_to_riqi(udays + beg, rizis + beg, end - beg);
+    });
+}
+
+} // namespace iw17::parallel
+
+#endif // IW_PARALLEL_HPP
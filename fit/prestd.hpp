@@ -1,5 +1,5 @@
 #ifndef IW_PRESTD_HPP
-#define IW_PRESTD_HPP 20250613L
+#define IW_PRESTD_HPP 20251016L
 
 #include <type_traits>
 
@@ -42,6 +42,21 @@ Out> bit_cast(In val) noexcept {
     return __builtin_bit_cast(Out, val);
 }
 
+// as `std::is_constant_evaluated` in C++20
+[[nodiscard]] constexpr bool is_constant_evaluated() noexcept {
+    return __builtin_is_constant_evaluated();
+}
+
+// SWAR, as `std::popcount` in C++20
+[[nodiscard]] constexpr int popcount(uint64_t val) noexcept {
+    constexpr uint64_t M1 = 0x5555555555555555, M2 = 0x3333333333333333;
+    constexpr uint64_t M4 = 0x0f0f0f0f0f0f0f0f, H8 = 0x0101010101010101;
+    val -= (val >> 1) & M1;
+    val = (val & M2) + ((val >> 2) & M2);
+    val = (val + (val >> 4)) & M4;
+    return int((val * H8) >> 56);
+}
+
 namespace _sct { // struct
 
 template <uint64_t N>
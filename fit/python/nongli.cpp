@@ -0,0 +1,328 @@
+// Python extension over arrays of `fit/`, by the buffer protocol
+//
+//   udays = numpy.arange(19000, 20000, dtype=numpy.int32)
+//   nians = numpy.empty(1000, numpy.int16), ...
+//   nongli.uday_to_riqi(udays, nians, ryues, tians)
+//
+// Inputs and outputs are C-contiguous buffers of signed integers of
+// the sizes below, allocated by callers, e.g. numpy arrays or
+// `array.array`s. Chunks run in parallel with the GIL released. Keys
+// out of range are kept in place, with zeros in `riqi`s, -1 in
+// `bazi`s, INT32_MIN in `cjie`s and INT64_MIN in usecs.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "../parallel.hpp"
+
+namespace {
+
+using namespace iw17;
+
+constexpr uint64_t BLOCK = 1024; // `riqi`s split into arrays at once
+
+// a buffer of `T`, released at the end of scope
+template <class T>
+struct buffer {
+
+// none acquired if an error is pending, so checked once after all
+buffer(PyObject *obj, bool out, const char *name) noexcept {
+    if (PyErr_Occurred()) {
+        return;
+    }
+    int flags = PyBUF_FORMAT | PyBUF_C_CONTIGUOUS;
+    if (PyObject_GetBuffer(obj, &buf, flags | (out ? PyBUF_WRITABLE : 0))
+        != 0) {
+        return;
+    }
+    held = true;
+    const char *fmt = (buf.format != nullptr) ? buf.format : "B";
+    char order = (std::strchr("@=<>!", *fmt) != nullptr) ? *fmt++ : '@';
+    bool swapped = (order == '<') ? !PY_LITTLE_ENDIAN
+        : (order == '>' || order == '!') && PY_LITTLE_ENDIAN;
+    bool sign = fmt[0] != '\0' && fmt[1] == '\0'
+        && std::strchr("bhilq", fmt[0]) != nullptr;
+    if (!sign || buf.itemsize != Py_ssize_t(sizeof(T))
+        || (swapped && sizeof(T) > 1)) {
+        PyErr_Format(PyExc_TypeError,
+            "%s: expected native int%d items, got '%s'",
+            name, int(8 * sizeof(T)), buf.format ? buf.format : "B");
+        return;
+    }
+    data = static_cast<T *>(buf.buf);
+    size = uint64_t(buf.len) / sizeof(T);
+}
+
+buffer(const buffer &) = delete;
+
+buffer &operator=(const buffer &) = delete;
+
+~buffer() {
+    if (held) {
+        PyBuffer_Release(&buf);
+    }
+}
+
+// false with ValueError if not of `num` items
+bool sized(uint64_t num, const char *name) const noexcept {
+    if (size != num) {
+        PyErr_Format(PyExc_ValueError, "%s: expected %llu items, got %llu",
+            name, (unsigned long long)num, (unsigned long long)size);
+        return false;
+    }
+    return true;
+}
+
+Py_buffer buf = {};
+bool held = false;
+T *data = nullptr;
+uint64_t size = 0;
+
+}; // struct buffer
+
+// workers on all cores, started on first use, running one job at a time
+parallel::pool &shared_pool() {
+    static parallel::pool exec;
+    return exec;
+}
+
+// chunks of `[0, num)` into `func(beg, end)`, without the GIL
+template <class Func>
+void run(uint64_t num, Func func) {
+    Py_BEGIN_ALLOW_THREADS
+    shared_pool().run(num, func);
+    Py_END_ALLOW_THREADS
+}
+
+// runs of `keys` in [lo, hi) into `func(beg, end)`, others `skip(i)`
+template <class T, class Func, class Skip>
+void by_runs(
+    const T *keys, uint64_t beg, uint64_t end, T lo, T hi,
+    Func func, Skip skip
+) {
+    while (beg < end) {
+        uint64_t mid = beg;
+        while (mid < end && keys[mid] >= lo && keys[mid] < hi) {
+            mid++;
+        }
+        if (mid > beg) {
+            func(beg, mid);
+        }
+        if (mid < end) {
+            skip(mid);
+        }
+        beg = mid + 1;
+    }
+}
+
+// udays and usecs valid in [min, max), as in `nongli_annotate`
+constexpr int32_t UDAY_MIN = cyue_to_uday(nian_to_cyue(NIAN_MIN));
+constexpr int32_t UDAY_MAX = cyue_to_uday(nian_to_cyue(NIAN_MAX + 1));
+constexpr int64_t USEC_MIN = cjie_to_usec(CJIE_MIN);
+constexpr int64_t USEC_MAX = cjie_to_usec(CJIE_MAX);
+constexpr int64_t BAZI_MIN = std::max(USEC_MIN, uday_to_usec(UDAY_MIN));
+constexpr int64_t BAZI_MAX = std::min(USEC_MAX, uday_to_usec(UDAY_MAX));
+
+PyObject *uday_to_riqi(PyObject *, PyObject *args) {
+    PyObject *oud, *oni, *ory, *oti;
+    if (!PyArg_ParseTuple(args, "OOOO:uday_to_riqi",
+        &oud, &oni, &ory, &oti)) {
+        return nullptr;
+    }
+    buffer<int32_t> udays(oud, false, "udays");
+    buffer<int16_t> nians(oni, true, "nians");
+    buffer<int8_t> ryues(ory, true, "ryues");
+    buffer<int8_t> tians(oti, true, "tians");
+    uint64_t num = udays.size;
+    if (PyErr_Occurred() || !nians.sized(num, "nians")
+        || !ryues.sized(num, "ryues") || !tians.sized(num, "tians")) {
+        return nullptr;
+    }
+    const int32_t *ud = udays.data;
+    int16_t *ni = nians.data;
+    int8_t *ry = ryues.data, *ti = tians.data;
+    auto split = [=](uint64_t beg, uint64_t end) {
+        riqi rizis[BLOCK];
+        for (uint64_t i = beg; i < end; i += BLOCK) {
+            uint64_t len = std::min(BLOCK, end - i);
+            batch::uday_to_riqi(ud + i, rizis, len);
+            for (uint64_t k = 0; k < len; k++) {
+                auto [nian, ryue, tian] = rizis[k];
+                ni[i + k] = nian, ry[i + k] = ryue, ti[i + k] = tian;
+            }
+        }
+    };
+    auto skip = [=](uint64_t i) {
+        ni[i] = 0, ry[i] = 0, ti[i] = 0;
+    };
+    run(num, [=](uint64_t beg, uint64_t end) noexcept {
+        by_runs(ud, beg, end, UDAY_MIN, UDAY_MAX, split, skip);
+    });
+    Py_RETURN_NONE;
+}
+
+PyObject *usec_to_cjie(PyObject *, PyObject *args) {
+    PyObject *ous, *ocj;
+    if (!PyArg_ParseTuple(args, "OO:usec_to_cjie", &ous, &ocj)) {
+        return nullptr;
+    }
+    buffer<int64_t> usecs(ous, false, "usecs");
+    buffer<int32_t> cjies(ocj, true, "cjies");
+    if (PyErr_Occurred() || !cjies.sized(usecs.size, "cjies")) {
+        return nullptr;
+    }
+    const int64_t *us = usecs.data;
+    int32_t *cj = cjies.data;
+    run(usecs.size, [=](uint64_t beg, uint64_t end) noexcept {
+        for (uint64_t i = beg; i < end; i++) {
+            bool valid = us[i] >= USEC_MIN && us[i] < USEC_MAX;
+            cj[i] = valid ? iw17::usec_to_cjie(us[i]) : INT32_MIN;
+        }
+    });
+    Py_RETURN_NONE;
+}
+
+PyObject *cjie_to_usec(PyObject *, PyObject *args) {
+    PyObject *ocj, *ous;
+    if (!PyArg_ParseTuple(args, "OO:cjie_to_usec", &ocj, &ous)) {
+        return nullptr;
+    }
+    buffer<int32_t> cjies(ocj, false, "cjies");
+    buffer<int64_t> usecs(ous, true, "usecs");
+    if (PyErr_Occurred() || !usecs.sized(cjies.size, "usecs")) {
+        return nullptr;
+    }
+    const int32_t *cj = cjies.data;
+    int64_t *us = usecs.data;
+    run(cjies.size, [=](uint64_t beg, uint64_t end) noexcept {
+        for (uint64_t i = beg; i < end; i++) {
+            bool valid = cj[i] >= CJIE_MIN && cj[i] <= CJIE_MAX;
+            us[i] = valid ? iw17::cjie_to_usec(cj[i]) : INT64_MIN;
+        }
+    });
+    Py_RETURN_NONE;
+}
+
+// `bazis` of 4 `ganzhi`s per usec, `nian`, `yue`, `ri` and `shi`
+PyObject *usec_to_bazi(PyObject *, PyObject *args) {
+    PyObject *ous, *obz;
+    double lon = 120.0;
+    if (!PyArg_ParseTuple(args, "OO|d:usec_to_bazi", &ous, &obz, &lon)) {
+        return nullptr;
+    }
+    buffer<int64_t> usecs(ous, false, "usecs");
+    buffer<int8_t> bazis(obz, true, "bazis");
+    if (PyErr_Occurred() || !bazis.sized(4 * usecs.size, "bazis")) {
+        return nullptr;
+    }
+    static_assert(sizeof(bazi) == 4, "4 `ganzhi`s of 1 byte");
+    const int64_t *us = usecs.data;
+    int8_t *bz = bazis.data;
+    auto fill = [=](uint64_t beg, uint64_t end) {
+        bazi zhus[BLOCK];
+        for (uint64_t i = beg; i < end; i += BLOCK) {
+            uint64_t len = std::min(BLOCK, end - i);
+            batch::usec_to_bazi(us + i, zhus, len, lon);
+            std::memcpy(bz + 4 * i, zhus, 4 * len);
+        }
+    };
+    auto skip = [=](uint64_t i) {
+        std::memset(bz + 4 * i, -1, 4);
+    };
+    run(usecs.size, [=](uint64_t beg, uint64_t end) noexcept {
+        by_runs(us, beg, end, BAZI_MIN, BAZI_MAX, fill, skip);
+    });
+    Py_RETURN_NONE;
+}
+
+PyObject *nian_to_ganzhi(PyObject *, PyObject *args) {
+    PyObject *oni, *ozh;
+    if (!PyArg_ParseTuple(args, "OO:nian_to_ganzhi", &oni, &ozh)) {
+        return nullptr;
+    }
+    buffer<int16_t> nians(oni, false, "nians");
+    buffer<int8_t> zhus(ozh, true, "zhus");
+    if (PyErr_Occurred() || !zhus.sized(nians.size, "zhus")) {
+        return nullptr;
+    }
+    const int16_t *ni = nians.data;
+    int8_t *zh = zhus.data;
+    run(nians.size, [=](uint64_t beg, uint64_t end) noexcept {
+        for (uint64_t i = beg; i < end; i++) {
+            zh[i] = int8_t(iw17::nian_to_ganzhi(ni[i]));
+        }
+    });
+    Py_RETURN_NONE;
+}
+
+PyObject *uday_to_ganzhi(PyObject *, PyObject *args) {
+    PyObject *oud, *ozh;
+    if (!PyArg_ParseTuple(args, "OO:uday_to_ganzhi", &oud, &ozh)) {
+        return nullptr;
+    }
+    buffer<int32_t> udays(oud, false, "udays");
+    buffer<int8_t> zhus(ozh, true, "zhus");
+    if (PyErr_Occurred() || !zhus.sized(udays.size, "zhus")) {
+        return nullptr;
+    }
+    const int32_t *ud = udays.data;
+    int8_t *zh = zhus.data;
+    run(udays.size, [=](uint64_t beg, uint64_t end) noexcept {
+        for (uint64_t i = beg; i < end; i++) {
+            zh[i] = int8_t(iw17::uday_to_ganzhi(ud[i]));
+        }
+    });
+    Py_RETURN_NONE;
+}
+
+PyMethodDef METHODS[] = {
+    {"uday_to_riqi", uday_to_riqi, METH_VARARGS,
+        "uday_to_riqi(udays, nians, ryues, tians)\n"
+        "int32 udays into int16 nians, int8 ryues and int8 tians."},
+    {"usec_to_cjie", usec_to_cjie, METH_VARARGS,
+        "usec_to_cjie(usecs, cjies)\n"
+        "int64 usecs into int32 cjies."},
+    {"cjie_to_usec", cjie_to_usec, METH_VARARGS,
+        "cjie_to_usec(cjies, usecs)\n"
+        "int32 cjies into int64 usecs."},
+    {"usec_to_bazi", usec_to_bazi, METH_VARARGS,
+        "usec_to_bazi(usecs, bazis, lon=120.0)\n"
+        "int64 usecs into int8 bazis, 4 ganzhis each."},
+    {"nian_to_ganzhi", nian_to_ganzhi, METH_VARARGS,
+        "nian_to_ganzhi(nians, zhus)\n"
+        "int16 nians into int8 ganzhis."},
+    {"uday_to_ganzhi", uday_to_ganzhi, METH_VARARGS,
+        "uday_to_ganzhi(udays, zhus)\n"
+        "int32 udays into int8 ganzhis."},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyModuleDef MODULE = {
+    PyModuleDef_HEAD_INIT, "nongli",
+    "Arrays of `fit/` by the buffer protocol, in parallel.",
+    -1, METHODS, nullptr, nullptr, nullptr, nullptr,
+};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit_nongli() {
+    PyObject *mod = PyModule_Create(&MODULE);
+    if (mod == nullptr) {
+        return nullptr;
+    }
+    // ranges of keys, others kept in place
+    if (PyModule_AddIntConstant(mod, "NIAN_MIN", NIAN_MIN) != 0
+        || PyModule_AddIntConstant(mod, "NIAN_MAX", NIAN_MAX) != 0
+        || PyModule_AddIntConstant(mod, "CJIE_MIN", CJIE_MIN) != 0
+        || PyModule_AddIntConstant(mod, "CJIE_MAX", CJIE_MAX) != 0
+        || PyModule_AddIntConstant(mod, "UDAY_MIN", UDAY_MIN) != 0
+        || PyModule_AddIntConstant(mod, "UDAY_MAX", UDAY_MAX) != 0) {
+        Py_DECREF(mod);
+        return nullptr;
+    }
+    return mod;
+}
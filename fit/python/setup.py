@@ -0,0 +1,55 @@
+'''
+Builds the optional extension `nongli` over the headers in `fit/`.
+Note: No network is needed, with setuptools and a C++17 compiler.
+
+Examples:
+    $ python3 setup.py build_ext --inplace
+    $ pip install --no-build-isolation .
+'''
+
+import typing as tp
+
+from setuptools import Extension, setup
+from setuptools.command.build_ext import build_ext
+
+
+# all table backends, as in `nongli_annotate`
+_MACROS: list[tuple[str, str]] = [
+    ('IW_NONGLI_DENSE', '1'),
+    ('IW_NONGLI_UDAY_INDEX', '1'),
+    ('IW_NONGLI_JIE_INDEX', '1'),
+    ('IW_NONGLI_EOT_CACHE', '1'),
+]
+
+_ARGS: dict[str, tuple[list[str], list[str]]] = {
+    'msvc': (['/std:c++17', '/O2', '/constexpr:steps10000000'], []),
+    'unix': (['-std=c++17', '-O2', '-pthread'], ['-pthread']),
+}
+
+
+class BuildExt(build_ext):
+    '''
+    Adds flags by the compiler found, as `fit/test/CMakeLists.txt`.
+    '''
+
+    def build_extensions(self: tp.Self) -> None:
+        kind: str = self.compiler.compiler_type
+        comp, link = _ARGS.get(kind, _ARGS['unix'])
+        for ext in self.extensions:
+            ext.extra_compile_args = comp
+            ext.extra_link_args = link
+        super().build_extensions()
+
+
+setup(
+    name='nongli',
+    version='1.1.2',
+    description='Arrays of nongli by the buffer protocol, in parallel',
+    ext_modules=[
+        Extension(
+            'nongli', ['nongli.cpp'],
+            include_dirs=['..'], define_macros=_MACROS, language='c++',
+        ),
+    ],
+    cmdclass={'build_ext': BuildExt},
+)
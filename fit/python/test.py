@@ -0,0 +1,99 @@
+'''
+Tests the extension `nongli`, built in place by `setup.py`.
+Note: Only `array` is used, while numpy arrays work alike.
+
+Examples:
+    $ python3 setup.py build_ext --inplace && python3 test.py
+'''
+
+import array
+import unittest
+
+import nongli
+
+
+# unix seconds, and `bazi`s at 119.0 degrees, as in `ganzhi.cpp`
+_USECS: list[int] = [0, 1079857804, 1709136666, 1738617617]
+_BAZIS: list[int] = [
+    45, 12, 17, 28,
+    20, 3, 35, 8,
+    40, 2, 58, 48,
+    41, 14, 40, 3,
+]
+
+
+class TestNongli(unittest.TestCase):
+
+    def test_riqi(self) -> None:
+        lo, hi = nongli.UDAY_MIN, nongli.UDAY_MAX
+        udays = array.array('i', [18375, 18405, lo - 1, hi])
+        nians = array.array('h', [7] * 4)
+        ryues, tians = array.array('b', [7] * 4), array.array('b', [7] * 4)
+        nongli.uday_to_riqi(udays, nians, ryues, tians)
+        self.assertEqual(list(nians), [2020, 2020, 0, 0])
+        self.assertEqual(list(ryues), [8, 9, 0, 0])
+        self.assertEqual(list(tians), [1, 1, 0, 0])
+
+    def test_riqi_all(self) -> None:
+        # in parallel chunks, tians counted up from 1 in each `yue`
+        lo, hi = nongli.UDAY_MIN, nongli.UDAY_MAX
+        udays = array.array('i', range(lo, hi))
+        nians = array.array('h', bytes(2 * len(udays)))
+        ryues = array.array('b', bytes(len(udays)))
+        tians = array.array('b', bytes(len(udays)))
+        nongli.uday_to_riqi(udays, nians, ryues, tians)
+        self.assertEqual((nians[0], ryues[0], tians[0]),
+            (nongli.NIAN_MIN, 2, 1))
+        self.assertEqual(nians[-1], nongli.NIAN_MAX)
+        for i in range(1, len(udays)):
+            same = (nians[i], ryues[i]) == (nians[i - 1], ryues[i - 1])
+            self.assertEqual(tians[i], tians[i - 1] + 1 if same else 1)
+
+    def test_cjie(self) -> None:
+        # back and forth over all `jie`s
+        cjies = array.array('i', range(nongli.CJIE_MIN, nongli.CJIE_MAX))
+        usecs = array.array('q', bytes(8 * len(cjies)))
+        nongli.cjie_to_usec(cjies, usecs)
+        backs = array.array('i', bytes(4 * len(cjies)))
+        nongli.usec_to_cjie(usecs, backs)
+        self.assertEqual(backs, cjies)
+        befores = array.array('q', [usec - 1 for usec in usecs])
+        nongli.usec_to_cjie(befores, backs)
+        self.assertEqual(backs[1:], cjies[:-1])
+        self.assertEqual(backs[0], -2 ** 31) # out of range
+        outs = array.array('q', [0])
+        nongli.cjie_to_usec(array.array('i', [nongli.CJIE_MAX + 1]), outs)
+        self.assertEqual(outs[0], -2 ** 63)
+
+    def test_bazi(self) -> None:
+        usecs = array.array('q', _USECS + [-2 ** 63])
+        bazis = array.array('b', bytes(4 * len(usecs)))
+        nongli.usec_to_bazi(usecs, bazis, 119.0)
+        self.assertEqual(list(bazis), _BAZIS + [-1] * 4)
+
+    def test_ganzhi(self) -> None:
+        nians = array.array('h', [1984, 2024, 1900])
+        zhus = array.array('b', bytes(3))
+        nongli.nian_to_ganzhi(nians, zhus)
+        self.assertEqual(list(zhus), [0, 40, 36])
+        # days of `_USECS`, the 3rd one past its `bazi` in solar time
+        udays = array.array('i', [0, 12498, 19782, 20123])
+        zhus = array.array('b', bytes(4))
+        nongli.uday_to_ganzhi(udays, zhus)
+        self.assertEqual(list(zhus), [17, 35, 59, 40])
+
+    def test_errors(self) -> None:
+        udays, nians = array.array('i', [0]), array.array('h', [0])
+        zhus = array.array('b', [0])
+        with self.assertRaises(TypeError): # int32 for nians
+            nongli.uday_to_riqi(udays, udays, zhus, zhus)
+        with self.assertRaises(TypeError): # unsigned
+            nongli.nian_to_ganzhi(nians, bytearray(1))
+        with self.assertRaises(BufferError): # not writable
+            nongli.nian_to_ganzhi(nians, bytes(1))
+        with self.assertRaises(ValueError):
+            nongli.nian_to_ganzhi(nians, array.array('b', [0, 0]))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,224 @@
+#ifndef IW_RANGE_HPP
+#define IW_RANGE_HPP 20251016L
+
+#include <cstdint>
+#include <iterator>
+
+#include "nongli.hpp"
+
+namespace iw17 {
+
+struct tian_info { // all about a day
+    int32_t uday;
+    date locd;
+    riqi rizi;
+    ganzhi zhu; // of `tian`
+    jieqi jie; // latest up to the end of day, in UTC+8
+    bool jiao; // whether `jie` starts on the day
+};
+
+namespace _rng { // incremental states
+
+// uday in UTC+8 on which `cjie` starts
+constexpr int32_t cjie_to_uday(int32_t cjie) noexcept {
+    return usec_to_uday(cjie_to_usec(cjie));
+}
+
+// no data out of [MIN, MAX + 1], treated as far away
+inline constexpr int32_t FAR_PAST = INT32_MIN, FAR_FUTURE = INT32_MAX;
+
+inline constexpr int32_t UJ_MAX = cjie_to_uday(CJIE_MAX);
+
+constexpr int32_t uday_to_cjie(int32_t uday) noexcept {
+    if (uday >= UJ_MAX) { // stays on the last `jie`
+        return CJIE_MAX;
+    }
+    return usec_to_cjie(uday_to_usec(uday + 1) - 1);
+}
+
+} // namespace _rng
+
+// over udays of `nian`s in [NIAN_MIN, NIAN_MAX], stepping both ways;
+// an input iterator only, as `reference` is by value
+struct riqi_iter {
+
+using iterator_category = std::input_iterator_tag;
+using value_type = tian_info;
+using difference_type = int64_t;
+using pointer = const tian_info *;
+using reference = tian_info; // by value, not stashed
+
+tian_info info;
+int32_t cyue, cy01, cynx; // `cyue`s of `yue`, `nian`, next `nian`
+int32_t ud01, udnx; // udays of `yue` and next `yue`
+int32_t cjie, udjq, udjn; // udays of `jie` and next `jie`
+int8_t run, ndays; // days in month of `locd`
+
+constexpr riqi_iter() noexcept: info{}, cyue(0), cy01(0), cynx(0),
+    ud01(0), udnx(0), cjie(0), udjq(0), udjn(0), run(0), ndays(0) {}
+
+explicit constexpr riqi_iter(int32_t uday) noexcept: riqi_iter() {
+    info.uday = uday;
+    info.locd = uday_to_date(uday);
+    ndays = days_in_month(info.locd.year, info.locd.mon);
+    info.rizi = uday_to_riqi(uday);
+    info.zhu = uday_to_ganzhi(uday);
+    auto [nian, ryue, tian] = info.rizi;
+    run = nian_to_run(nian);
+    cy01 = nian_to_cyue(nian), cynx = this->nian_to_cynx(nian);
+    cyue = cy01 + ryue_to_nyue(ryue, run);
+    ud01 = uday - tian + 1, udnx = this->cyue_to_udnx(cyue);
+    cjie = _rng::uday_to_cjie(uday);
+    udjq = this->cjie_to_udjq(cjie), udjn = this->cjie_to_udjn(cjie);
+    info.jie = cjie_to_shihou(cjie).jie;
+    info.jiao = uday == udjq;
+}
+
+constexpr tian_info operator*() const noexcept {
+    return info;
+}
+
+constexpr const tian_info *operator->() const noexcept {
+    return &info;
+}
+
+constexpr riqi_iter &operator++() noexcept {
+    int32_t uday = ++info.uday;
+    auto &[year, mon, day] = info.locd;
+    if (++day > ndays) {
+        day = 1;
+        if (++mon > 12) {
+            mon = 1, year += 1;
+        }
+        ndays = days_in_month(year, mon);
+    }
+    int8_t gord = int8_t(info.zhu) + 1;
+    info.zhu = ganzhi(gord - 60 * (gord == 60));
+    if (uday == udnx) { // next `yue`
+        if (++cyue == cynx) {
+            int16_t nian = ++info.rizi.nian;
+            run = nian_to_run(nian);
+            cy01 = cynx, cynx = this->nian_to_cynx(nian);
+        }
+        ud01 = udnx, udnx = this->cyue_to_udnx(cyue);
+        info.rizi.ryue = nyue_to_ryue(cyue - cy01, run);
+        info.rizi.tian = 1;
+    } else {
+        info.rizi.tian += 1;
+    }
+    if (uday == udjn) { // next `jie`
+        cjie += 1, udjq = udjn, udjn = this->cjie_to_udjn(cjie);
+        info.jie = cjie_to_shihou(cjie).jie;
+    }
+    info.jiao = uday == udjq;
+    return *this;
+}
+
+constexpr riqi_iter &operator--() noexcept {
+    int32_t uday = --info.uday;
+    auto &[year, mon, day] = info.locd;
+    if (--day < 1) {
+        if (--mon < 1) {
+            mon = 12, year -= 1;
+        }
+        day = ndays = days_in_month(year, mon);
+    }
+    int8_t gord = int8_t(info.zhu) - 1;
+    info.zhu = ganzhi(gord + 60 * (gord < 0));
+    if (uday < ud01) { // last `yue`
+        if (cyue-- == cy01) {
+            int16_t nian = --info.rizi.nian;
+            run = nian_to_run(nian);
+            cynx = cy01, cy01 = nian_to_cyue(nian);
+        }
+        udnx = ud01, ud01 = cyue_to_uday(cyue);
+        info.rizi.ryue = nyue_to_ryue(cyue - cy01, run);
+        info.rizi.tian = udnx - ud01;
+    } else {
+        info.rizi.tian -= 1;
+    }
+    if (uday < udjq) { // last `jie`
+        cjie -= 1, udjn = udjq, udjq = this->cjie_to_udjq(cjie);
+        info.jie = cjie_to_shihou(cjie).jie;
+    }
+    info.jiao = uday == udjq;
+    return *this;
+}
+
+constexpr riqi_iter operator++(int) noexcept {
+    riqi_iter old = *this;
+    ++*this;
+    return old;
+}
+
+constexpr riqi_iter operator--(int) noexcept {
+    riqi_iter old = *this;
+    --*this;
+    return old;
+}
+
+friend constexpr bool operator==(
+    const riqi_iter &a, const riqi_iter &b
+) noexcept {
+    return a.info.uday == b.info.uday;
+}
+
+friend constexpr bool operator!=(
+    const riqi_iter &a, const riqi_iter &b
+) noexcept {
+    return a.info.uday != b.info.uday;
+}
+
+private:
+
+static constexpr int32_t nian_to_cynx(int16_t nian) noexcept {
+    return (nian <= NIAN_MAX) ? nian_to_cyue(nian + 1) : _rng::FAR_FUTURE;
+}
+
+static constexpr int32_t cyue_to_udnx(int32_t cyue) noexcept {
+    return (cyue <= CYUE_MAX) ? cyue_to_uday(cyue + 1) : _rng::FAR_FUTURE;
+}
+
+static constexpr int32_t cjie_to_udjq(int32_t cjie) noexcept {
+    return (cjie >= CJIE_MIN) ? _rng::cjie_to_uday(cjie) : _rng::FAR_PAST;
+}
+
+static constexpr int32_t cjie_to_udjn(int32_t cjie) noexcept {
+    bool far = cjie >= CJIE_MAX;
+    return far ? _rng::FAR_FUTURE : _rng::cjie_to_uday(cjie + 1);
+}
+
+}; // struct riqi_iter
+
+// udays in [`first`, `last`], of `nian`s in [NIAN_MIN, NIAN_MAX]
+struct riqi_range {
+
+int32_t first, last;
+
+constexpr riqi_iter begin() const noexcept {
+    return riqi_iter(first);
+}
+
+constexpr riqi_iter end() const noexcept {
+    return ++riqi_iter(last);
+}
+
+constexpr uint64_t size() const noexcept {
+    return uint64_t(int64_t(last) - first + 1);
+}
+
+}; // struct riqi_range
+
+constexpr riqi_range nian_to_range(int16_t nian) noexcept {
+    int32_t ud01 = cyue_to_uday(nian_to_cyue(nian));
+    int32_t udnx = cyue_to_uday(nian_to_cyue(nian + 1));
+    return riqi_range{ud01, udnx - 1};
+}
+
+constexpr riqi_range date_to_range(date first, date last) noexcept {
+    return riqi_range{date_to_uday(first), date_to_uday(last)};
+}
+
+} // namespace iw17
+
+#endif // IW_RANGE_HPP
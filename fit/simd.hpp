@@ -0,0 +1,624 @@
+#ifndef IW_SIMD_HPP
+#define IW_SIMD_HPP 20251016L
+
+#include <cstdint>
+
+#include "nongli.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || \
+    defined(__i386__) || defined(_M_IX86)
+#define IW_SIMD_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER // MSVC
+#include <intrin.h>
+#endif // _MSC_VER
+#else // other architectures
+#define IW_SIMD_X86 0
+#endif // x86 or x64
+
+#ifdef _MSC_VER // MSVC, intrinsics always enabled
+#define IW_TARGET(isa)
+#else // GCC or Clang
+#define IW_TARGET(isa) __attribute__((target(isa)))
+#endif // _MSC_VER
+
+namespace iw17::simd {
+
+using namespace trim::limits;
+
+enum class isa: int8_t { // instruction sets, ascending
+    scalar, sse41, avx2,
+};
+
+namespace _cpu {
+
+inline isa probe() noexcept {
+#if !IW_SIMD_X86
+    return isa::scalar;
+#elif defined(_MSC_VER) // MSVC
+    int info[4] = {};
+    __cpuid(info, 0);
+    int leaves = info[0];
+    __cpuid(info, 1);
+    bool sse41 = (info[2] >> 19) & 1;
+    bool osxs = (info[2] >> 27) & 1; // OSXSAVE
+    bool avx = (info[2] >> 28) & 1;
+    bool avx2 = false;
+    if (leaves >= 7 && osxs && avx) {
+        __cpuidex(info, 7, 0);
+        bool ymms = (_xgetbv(0) & 0b0110) == 0b0110;
+        avx2 = ymms && ((info[1] >> 5) & 1);
+    }
+    return avx2 ? isa::avx2 : sse41 ? isa::sse41 : isa::scalar;
+#else // GCC or Clang
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return isa::sse41;
+    }
+    return isa::scalar;
+#endif // IW_SIMD_X86
+}
+
+} // namespace _cpu
+
+// best instruction set of the running CPU
+inline isa best_isa() noexcept {
+    static const isa BEST = _cpu::probe();
+    return BEST;
+}
+
+namespace _tab { // residuals ready for 32-bit gathers
+
+// pages flattened, with 3 bytes padded for gathers
+template <uint64_t N>
+struct flat_bytes {
+    uint8_t bytes[N + 3];
+};
+
+template <uint64_t N>
+constexpr flat_bytes<N> flatten(
+    const uint8_t *const *arrs, int64_t page
+) noexcept {
+    flat_bytes<N> flat = {};
+    for (uint64_t i = 0; i < N; i++) {
+        auto [iarr, iloc] = math::cdivmod<uint64_t>(i, page);
+        flat.bytes[i] = arrs[iarr][iloc];
+    }
+    return flat;
+}
+
+inline constexpr const uint8_t *NY_ARRY[] = {
+    trim::NY_RESY,
+};
+
+// `nian`s in [NIAN_MIN, NIAN_MAX + 1], 1 bit each
+inline constexpr uint64_t NY_SIZE = (NIAN_MAX + 1 - NIAN_MIN) / 8 + 1;
+
+inline constexpr flat_bytes<NY_SIZE> NY_FLAT =
+    flatten<NY_SIZE>(NY_ARRY, sizeof(trim::NY_RESY));
+
+// `cyue`s in [CYUE_MIN, CYUE_MAX + 1], 2 bits each
+inline constexpr uint64_t YD_SIZE = (CYUE_MAX + 1 - CYUE_MIN) / 4 + 1;
+
+inline constexpr flat_bytes<YD_SIZE> YD_FLAT =
+    flatten<YD_SIZE>(trim::YD_ARRD, trim::YD_PAGE);
+
+// `cjie`s in [CJIE_MIN, CJIE_MAX], 12 bits each
+inline constexpr uint64_t JS_SIZE = [] {
+    int32_t ijie = CJIE_MAX - CJIE_MIN;
+    return uint64_t(ijie + (ijie >> 1) + 2);
+}();
+
+inline constexpr flat_bytes<JS_SIZE> JS_FLAT =
+    flatten<JS_SIZE>(trim::JS_ARRS, trim::JS_PAGE);
+
+constexpr bool fits_i32(int64_t k, int64_t b, int64_t lo, int64_t hi) {
+    constexpr int64_t I32_MIN = -(int64_t(1) << 31);
+    constexpr int64_t I32_MAX = (int64_t(1) << 31) - 1;
+    int64_t ylo = k * lo + b, yhi = k * hi + b;
+    return ylo >= I32_MIN && ylo <= I32_MAX
+        && yhi >= I32_MIN && yhi <= I32_MAX;
+}
+
+// whether affine fits stay in 32-bit lanes
+inline constexpr bool NY_I32 =
+    fits_i32(trim::NY_COEF[0], trim::NY_COEF[1], NIAN_MIN, NIAN_MAX + 1) &&
+    fits_i32(trim::NY_COEF[2], trim::NY_COEF[3], NIAN_MIN, NIAN_MAX + 1);
+
+inline constexpr bool YD_I32 =
+    fits_i32(trim::YD_COEF[0], trim::YD_COEF[1], CYUE_MIN, CYUE_MAX + 1) &&
+    fits_i32(trim::YD_COEF[2], trim::YD_COEF[3], CYUE_MIN, CYUE_MAX + 1);
+
+} // namespace _tab
+
+namespace _one { // scalar fallback
+
+inline void nian_to_cyue(
+    const int16_t *nians, int32_t *cyues, uint64_t num
+) noexcept {
+    for (uint64_t i = 0; i < num; i++) {
+        cyues[i] = iw17::nian_to_cyue(nians[i]);
+    }
+}
+
+inline void cyue_to_uday(
+    const int32_t *cyues, int32_t *udays, uint64_t num
+) noexcept {
+    for (uint64_t i = 0; i < num; i++) {
+        udays[i] = iw17::cyue_to_uday(cyues[i]);
+    }
+}
+
+inline void cjie_to_usec(
+    const int32_t *cjies, int64_t *usecs, uint64_t num
+) noexcept {
+    for (uint64_t i = 0; i < num; i++) {
+        usecs[i] = iw17::cjie_to_usec(cjies[i]);
+    }
+}
+
+inline void date_to_uday(
+    const date *dates, int32_t *udays, uint64_t num
+) noexcept {
+    for (uint64_t i = 0; i < num; i++) {
+        udays[i] = iw17::date_to_uday(dates[i]);
+    }
+}
+
+inline void uday_to_date(
+    const int32_t *udays, date *dates, uint64_t num
+) noexcept {
+    for (uint64_t i = 0; i < num; i++) {
+        dates[i] = iw17::uday_to_date(udays[i]);
+    }
+}
+
+} // namespace _one
+
+#if IW_SIMD_X86
+
+namespace _sse { // SSE4.1, 4 lanes, scalar gathers
+
+// `y = k0 * x + b0 + (k1 * x + b1 >> nb)` in 32-bit lanes
+IW_TARGET("sse4.1")
+inline __m128i lv1_pred(
+    __m128i x, const int64_t *coef, int64_t nb
+) noexcept {
+    __m128i k0 = _mm_set1_epi32(int32_t(coef[0]));
+    __m128i b0 = _mm_set1_epi32(int32_t(coef[1]));
+    __m128i k1 = _mm_set1_epi32(int32_t(coef[2]));
+    __m128i b1 = _mm_set1_epi32(int32_t(coef[3]));
+    __m128i plin = _mm_add_epi32(_mm_mullo_epi32(k0, x), b0);
+    __m128i bfit = _mm_add_epi32(_mm_mullo_epi32(k1, x), b1);
+    __m128i bits = _mm_cvtsi32_si128(int32_t(nb));
+    return _mm_add_epi32(plin, _mm_sra_epi32(bfit, bits));
+}
+
+IW_TARGET("sse4.1")
+inline __m128i ny_resy(__m128i ires) noexcept {
+    const uint8_t *flat = _tab::NY_FLAT.bytes;
+    uint32_t i0 = _mm_extract_epi32(ires, 0);
+    uint32_t i1 = _mm_extract_epi32(ires, 1);
+    uint32_t i2 = _mm_extract_epi32(ires, 2);
+    uint32_t i3 = _mm_extract_epi32(ires, 3);
+    return _mm_setr_epi32(
+        (flat[i0 >> 3] >> (i0 & 7)) & 1,
+        (flat[i1 >> 3] >> (i1 & 7)) & 1,
+        (flat[i2 >> 3] >> (i2 & 7)) & 1,
+        (flat[i3 >> 3] >> (i3 & 7)) & 1
+    );
+}
+
+IW_TARGET("sse4.1")
+inline __m128i yd_resd(__m128i ires) noexcept {
+    const uint8_t *flat = _tab::YD_FLAT.bytes;
+    uint32_t i0 = _mm_extract_epi32(ires, 0);
+    uint32_t i1 = _mm_extract_epi32(ires, 1);
+    uint32_t i2 = _mm_extract_epi32(ires, 2);
+    uint32_t i3 = _mm_extract_epi32(ires, 3);
+    return _mm_setr_epi32(
+        (flat[i0 >> 2] >> (2 * (i0 & 3))) & 0b0011,
+        (flat[i1 >> 2] >> (2 * (i1 & 3))) & 0b0011,
+        (flat[i2 >> 2] >> (2 * (i2 & 3))) & 0b0011,
+        (flat[i3 >> 2] >> (2 * (i3 & 3))) & 0b0011
+    );
+}
+
+IW_TARGET("sse4.1")
+inline void nian_to_cyue(
+    const int16_t *nians, int32_t *cyues, uint64_t num
+) noexcept {
+    const __m128i nmin = _mm_set1_epi32(NIAN_MIN);
+    uint64_t i = 0;
+    for (; i + 4 <= num; i += 4) {
+        __m128i n16 = _mm_loadl_epi64((const __m128i *)(nians + i));
+        __m128i nian = _mm_cvtepi16_epi32(n16);
+        __m128i pred = lv1_pred(nian, trim::NY_COEF, trim::NY_BITS);
+        __m128i resy = ny_resy(_mm_sub_epi32(nian, nmin));
+        __m128i cyue = _mm_add_epi32(pred, resy);
+        _mm_storeu_si128((__m128i *)(cyues + i), cyue);
+    }
+    _one::nian_to_cyue(nians + i, cyues + i, num - i);
+}
+
+IW_TARGET("sse4.1")
+inline void cyue_to_uday(
+    const int32_t *cyues, int32_t *udays, uint64_t num
+) noexcept {
+    const __m128i ymin = _mm_set1_epi32(CYUE_MIN);
+    uint64_t i = 0;
+    for (; i + 4 <= num; i += 4) {
+        __m128i cyue = _mm_loadu_si128((const __m128i *)(cyues + i));
+        __m128i pred = lv1_pred(cyue, trim::YD_COEF, trim::YD_BITS);
+        __m128i resd = yd_resd(_mm_sub_epi32(cyue, ymin));
+        __m128i uday = _mm_add_epi32(pred, resd);
+        _mm_storeu_si128((__m128i *)(udays + i), uday);
+    }
+    _one::cyue_to_uday(cyues + i, udays + i, num - i);
+}
+
+} // namespace _sse
+
+namespace _avx { // AVX2, 8 lanes, hardware gathers
+
+// `y = k0 * x + b0 + (k1 * x + b1 >> nb)` in 32-bit lanes
+IW_TARGET("avx2")
+inline __m256i lv1_pred(
+    __m256i x, const int64_t *coef, int64_t nb
+) noexcept {
+    __m256i k0 = _mm256_set1_epi32(int32_t(coef[0]));
+    __m256i b0 = _mm256_set1_epi32(int32_t(coef[1]));
+    __m256i k1 = _mm256_set1_epi32(int32_t(coef[2]));
+    __m256i b1 = _mm256_set1_epi32(int32_t(coef[3]));
+    __m256i plin = _mm256_add_epi32(_mm256_mullo_epi32(k0, x), b0);
+    __m256i bfit = _mm256_add_epi32(_mm256_mullo_epi32(k1, x), b1);
+    __m128i bits = _mm_cvtsi32_si128(int32_t(nb));
+    return _mm256_add_epi32(plin, _mm256_sra_epi32(bfit, bits));
+}
+
+// gathers `nbit` bits per item from a flattened table
+IW_TARGET("avx2")
+inline __m256i gather_bits(
+    const uint8_t *flat, __m256i ires, int32_t lgib, int32_t nbit
+) noexcept {
+    // items per byte: `1 << lgib`, bits per item: `nbit`
+    __m256i iloc = _mm256_srl_epi32(ires, _mm_cvtsi32_si128(lgib));
+    __m256i imod = _mm256_set1_epi32((1 << lgib) - 1);
+    __m256i ibit = _mm256_and_si256(ires, imod);
+    ibit = _mm256_mullo_epi32(ibit, _mm256_set1_epi32(nbit));
+    __m256i word = _mm256_i32gather_epi32((const int *)flat, iloc, 1);
+    __m256i mask = _mm256_set1_epi32((1 << nbit) - 1);
+    return _mm256_and_si256(_mm256_srlv_epi32(word, ibit), mask);
+}
+
+IW_TARGET("avx2")
+inline void nian_to_cyue(
+    const int16_t *nians, int32_t *cyues, uint64_t num
+) noexcept {
+    const __m256i nmin = _mm256_set1_epi32(NIAN_MIN);
+    const uint8_t *flat = _tab::NY_FLAT.bytes;
+    uint64_t i = 0;
+    for (; i + 8 <= num; i += 8) {
+        __m128i n16 = _mm_loadu_si128((const __m128i *)(nians + i));
+        __m256i nian = _mm256_cvtepi16_epi32(n16);
+        __m256i pred = lv1_pred(nian, trim::NY_COEF, trim::NY_BITS);
+        __m256i ires = _mm256_sub_epi32(nian, nmin);
+        __m256i resy = gather_bits(flat, ires, 3, 1);
+        __m256i cyue = _mm256_add_epi32(pred, resy);
+        _mm256_storeu_si256((__m256i *)(cyues + i), cyue);
+    }
+    _one::nian_to_cyue(nians + i, cyues + i, num - i);
+}
+
+IW_TARGET("avx2")
+inline void cyue_to_uday(
+    const int32_t *cyues, int32_t *udays, uint64_t num
+) noexcept {
+    const __m256i ymin = _mm256_set1_epi32(CYUE_MIN);
+    const uint8_t *flat = _tab::YD_FLAT.bytes;
+    uint64_t i = 0;
+    for (; i + 8 <= num; i += 8) {
+        __m256i cyue = _mm256_loadu_si256((const __m256i *)(cyues + i));
+        __m256i pred = lv1_pred(cyue, trim::YD_COEF, trim::YD_BITS);
+        __m256i ires = _mm256_sub_epi32(cyue, ymin);
+        __m256i resd = gather_bits(flat, ires, 2, 2);
+        __m256i uday = _mm256_add_epi32(pred, resd);
+        _mm256_storeu_si256((__m256i *)(udays + i), uday);
+    }
+    _one::cyue_to_uday(cyues + i, udays + i, num - i);
+}
+
+// lower 64 bits of `a * b`, as AVX-512DQ `vpmullq`
+IW_TARGET("avx2")
+inline __m256i mullo_i64(__m256i a, __m256i b) noexcept {
+    __m256i lo = _mm256_mul_epu32(a, b);
+    __m256i hl = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b);
+    if constexpr (SUI_MIN < 0) { // upper half of `b` not zero
+        __m256i lh = _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32));
+        hl = _mm256_add_epi64(hl, lh);
+    }
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(hl, 32));
+}
+
+// arithmetic right shift, as AVX-512F `vpsraq`
+IW_TARGET("avx2")
+inline __m256i sra_i64(__m256i a, __m128i bits) noexcept {
+    __m256i sign = _mm256_set1_epi64x(int64_t(UINT64_C(1) << 63));
+    __m256i mask = _mm256_srl_epi64(sign, bits);
+    __m256i ashr = _mm256_srl_epi64(a, bits);
+    return _mm256_sub_epi64(_mm256_xor_si256(ashr, mask), mask);
+}
+
+// `js_pred` of 4 `cjie`s, exact in 64-bit lanes
+IW_TARGET("avx2")
+inline __m256i js_pred(__m128i cjie) noexcept {
+    // `pydivmod` by 24, exact via correctly rounded division
+    __m256d cjfl = _mm256_cvtepi32_pd(cjie);
+    __m256d sufl = _mm256_div_pd(cjfl, _mm256_set1_pd(24.0));
+    __m128i isui = _mm256_cvttpd_epi32(_mm256_floor_pd(sufl));
+    __m128i ijie = _mm_mullo_epi32(isui, _mm_set1_epi32(24));
+    ijie = _mm_sub_epi32(cjie, ijie);
+    __m128i su32 = _mm_add_epi32(isui, _mm_set1_epi32(1970));
+    __m256i sui = _mm256_cvtepi32_epi64(su32);
+    __m128i irow = _mm_mullo_epi32(ijie, _mm_set1_epi32(7));
+    const long long *coef = (const long long *)trim::JS_COEF[0];
+    __m128i bits = _mm_cvtsi32_si128(int32_t(trim::JS_BITS));
+    __m256i pfit = _mm256_i32gather_epi64(coef + 0, irow, 8);
+    for (int k = 1; k < 7; k++) {
+        __m256i ck = _mm256_i32gather_epi64(coef + k, irow, 8);
+        pfit = _mm256_add_epi64(sra_i64(mullo_i64(pfit, sui), bits), ck);
+    }
+    __m256i k0 = _mm256_set1_epi64x(trim::JS_CLIN[0]);
+    __m256i b0 = _mm256_set1_epi64x(trim::JS_CLIN[1]);
+    __m256i plin = _mm256_add_epi64(mullo_i64(k0, sui), b0);
+    return _mm256_add_epi64(plin, pfit);
+}
+
+// `js_ress` of 4 `cjie`s, unpacked from 12-bit pairs
+IW_TARGET("avx2")
+inline __m256i js_ress(__m128i cjie) noexcept {
+    __m128i ijie = _mm_sub_epi32(cjie, _mm_set1_epi32(CJIE_MIN));
+    __m128i isub = _mm_add_epi32(ijie, _mm_srai_epi32(ijie, 1));
+    const int *flat = (const int *)_tab::JS_FLAT.bytes;
+    __m128i pair = _mm_i32gather_epi32(flat, isub, 1);
+    __m128i odds = _mm_and_si128(cjie, _mm_set1_epi32(1));
+    pair = _mm_srlv_epi32(pair, _mm_slli_epi32(odds, 2));
+    pair = _mm_and_si128(pair, _mm_set1_epi32(0x0fff));
+    return _mm256_cvtepu32_epi64(pair);
+}
+
+IW_TARGET("avx2")
+inline void cjie_to_usec(
+    const int32_t *cjies, int64_t *usecs, uint64_t num
+) noexcept {
+    uint64_t i = 0;
+    for (; i + 4 <= num; i += 4) {
+        __m128i cjie = _mm_loadu_si128((const __m128i *)(cjies + i));
+        __m256i pred = js_pred(cjie);
+        __m256i ress = js_ress(cjie);
+        __m256i usec = _mm256_add_epi64(pred, ress);
+        _mm256_storeu_si256((__m256i *)(usecs + i), usec);
+    }
+    _one::cjie_to_usec(cjies + i, usecs + i, num - i);
+}
+
+// upper 32 bits of `a * b` in unsigned 32-bit lanes
+IW_TARGET("avx2")
+inline __m256i mulhi_u32(__m256i a, uint32_t b) noexcept {
+    __m256i bv = _mm256_set1_epi32(int32_t(b));
+    __m256i evens = _mm256_srli_epi64(_mm256_mul_epu32(a, bv), 32);
+    __m256i odds = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), bv);
+    return _mm256_blend_epi32(evens, odds, 0xaa);
+}
+
+// `iw17::date_to_uday` of 8 dates, lane by lane
+IW_TARGET("avx2")
+inline void date_to_uday(
+    const date *dates, int32_t *udays, uint64_t num
+) noexcept {
+    using namespace iw17::_eaf;
+    const __m256i ysft = _mm256_set1_epi32(YEAR_SHIFT);
+    const __m256i usft = _mm256_set1_epi32(UDAY_SHIFT + 1);
+    uint64_t i = 0;
+    for (; i + 8 <= num; i += 8) {
+        __m256i ymd = _mm256_loadu_si256((const __m256i *)(dates + i));
+        __m256i y = _mm256_srai_epi32(_mm256_slli_epi32(ymd, 16), 16);
+        __m256i m = _mm256_and_si256(_mm256_srli_epi32(ymd, 16),
+            _mm256_set1_epi32(0xff));
+        __m256i d = _mm256_srli_epi32(ymd, 24);
+        __m256i jf = _mm256_cmpgt_epi32(_mm256_set1_epi32(3), m);
+        __m256i ym = _mm256_add_epi32(_mm256_add_epi32(y, ysft), jf);
+        __m256i mm = _mm256_add_epi32(m,
+            _mm256_and_si256(jf, _mm256_set1_epi32(12)));
+        __m256i c = mulhi_u32(ym, 42949673);
+        __m256i dy = _mm256_mullo_epi32(ym, _mm256_set1_epi32(1461));
+        dy = _mm256_sub_epi32(_mm256_srli_epi32(dy, 2), c);
+        dy = _mm256_add_epi32(dy, _mm256_srli_epi32(c, 2));
+        __m256i dm = _mm256_mullo_epi32(mm, _mm256_set1_epi32(979));
+        dm = _mm256_srli_epi32(
+            _mm256_sub_epi32(dm, _mm256_set1_epi32(2919)), 5);
+        __m256i uday = _mm256_add_epi32(_mm256_add_epi32(dy, dm), d);
+        uday = _mm256_sub_epi32(uday, usft);
+        _mm256_storeu_si256((__m256i *)(udays + i), uday);
+    }
+    _one::date_to_uday(dates + i, udays + i, num - i);
+}
+
+// `iw17::uday_to_date` of 8 udays, lane by lane
+IW_TARGET("avx2")
+inline void uday_to_date(
+    const int32_t *udays, date *dates, uint64_t num
+) noexcept {
+    using namespace iw17::_eaf;
+    const __m256i usft = _mm256_set1_epi32(UDAY_SHIFT);
+    const __m256i threes = _mm256_set1_epi32(3);
+    uint64_t i = 0;
+    for (; i + 8 <= num; i += 8) {
+        __m256i uday = _mm256_loadu_si256((const __m256i *)(udays + i));
+        __m256i n1 = _mm256_slli_epi32(_mm256_add_epi32(uday, usft), 2);
+        n1 = _mm256_or_si256(n1, threes);
+        __m256i c = _mm256_srli_epi32(mulhi_u32(n1, 3853261556), 17);
+        __m256i n2 = _mm256_mullo_epi32(c, _mm256_set1_epi32(146097));
+        n2 = _mm256_or_si256(_mm256_sub_epi32(n1, n2), threes);
+        __m256i z = mulhi_u32(n2, 2939745);
+        __m256i ny = _mm256_mullo_epi32(z, _mm256_set1_epi32(1461));
+        ny = _mm256_srli_epi32(_mm256_sub_epi32(n2, ny), 2);
+        __m256i n3 = _mm256_mullo_epi32(ny, _mm256_set1_epi32(2141));
+        n3 = _mm256_add_epi32(n3, _mm256_set1_epi32(197913));
+        __m256i jf = _mm256_cmpgt_epi32(ny, _mm256_set1_epi32(305));
+        __m256i y = _mm256_mullo_epi32(c, _mm256_set1_epi32(100));
+        y = _mm256_sub_epi32(_mm256_add_epi32(y, z), jf);
+        y = _mm256_sub_epi32(y, _mm256_set1_epi32(YEAR_SHIFT));
+        __m256i m = _mm256_sub_epi32(_mm256_srli_epi32(n3, 16),
+            _mm256_and_si256(jf, _mm256_set1_epi32(12)));
+        __m256i d = _mm256_and_si256(n3, _mm256_set1_epi32(0xffff));
+        d = _mm256_mullo_epi32(d, _mm256_set1_epi32(62690));
+        d = _mm256_add_epi32(_mm256_srli_epi32(d, 27),
+            _mm256_set1_epi32(1));
+        __m256i ymd = _mm256_and_si256(y, _mm256_set1_epi32(0xffff));
+        ymd = _mm256_or_si256(ymd, _mm256_slli_epi32(m, 16));
+        ymd = _mm256_or_si256(ymd, _mm256_slli_epi32(d, 24));
+        _mm256_storeu_si256((__m256i *)(dates + i), ymd);
+    }
+    _one::uday_to_date(udays + i, dates + i, num - i);
+}
+
+} // namespace _avx
+
+#endif // IW_SIMD_X86
+
+// no more than `best_isa()` is taken
+inline void nian_to_cyue(
+    const int16_t *nians, int32_t *cyues, uint64_t num,
+    isa set = best_isa()
+) noexcept {
+    set = set < best_isa() ? set : best_isa();
+    switch (_tab::NY_I32 ? set : isa::scalar) {
+#if IW_SIMD_X86
+        case isa::avx2: return _avx::nian_to_cyue(nians, cyues, num);
+        case isa::sse41: return _sse::nian_to_cyue(nians, cyues, num);
+#endif // IW_SIMD_X86
+        default: return _one::nian_to_cyue(nians, cyues, num);
+    }
+}
+
+// no more than `best_isa()` is taken
+inline void cyue_to_uday(
+    const int32_t *cyues, int32_t *udays, uint64_t num,
+    isa set = best_isa()
+) noexcept {
+    set = set < best_isa() ? set : best_isa();
+    switch (_tab::YD_I32 ? set : isa::scalar) {
+#if IW_SIMD_X86
+        case isa::avx2: return _avx::cyue_to_uday(cyues, udays, num);
+        case isa::sse41: return _sse::cyue_to_uday(cyues, udays, num);
+#endif // IW_SIMD_X86
+        default: return _one::cyue_to_uday(cyues, udays, num);
+    }
+}
+
+// only AVX2 has 64-bit lanes worth taking
+inline void cjie_to_usec(
+    const int32_t *cjies, int64_t *usecs, uint64_t num,
+    isa set = best_isa()
+) noexcept {
+    set = set < best_isa() ? set : best_isa();
+    switch (set) {
+#if IW_SIMD_X86
+        case isa::avx2: return _avx::cjie_to_usec(cjies, usecs, num);
+#endif // IW_SIMD_X86
+        default: return _one::cjie_to_usec(cjies, usecs, num);
+    }
+}
+
+// only AVX2 has 32-bit `mulhi` worth taking
+inline void date_to_uday(
+    const date *dates, int32_t *udays, uint64_t num,
+    isa set = best_isa()
+) noexcept {
+    set = set < best_isa() ? set : best_isa();
+    switch (set) {
+#if IW_SIMD_X86
+        case isa::avx2: return _avx::date_to_uday(dates, udays, num);
+#endif // IW_SIMD_X86
+        default: return _one::date_to_uday(dates, udays, num);
+    }
+}
+
+// only AVX2 has 32-bit `mulhi` worth taking
+inline void uday_to_date(
+    const int32_t *udays, date *dates, uint64_t num,
+    isa set = best_isa()
+) noexcept {
+    set = set < best_isa() ? set : best_isa();
+    switch (set) {
+#if IW_SIMD_X86
+        case isa::avx2: return _avx::uday_to_date(udays, dates, num);
+#endif // IW_SIMD_X86
+        default: return _one::uday_to_date(udays, dates, num);
+    }
+}
+
+inline void shihou_to_usec(
+    const shihou *shis, int64_t *usecs, uint64_t num,
+    isa set = best_isa()
+) noexcept {
+    constexpr uint64_t STEP = 256;
+    int32_t cjies[STEP];
+    for (uint64_t i = 0; i < num; i += STEP) {
+        uint64_t size = num - i < STEP ? num - i : STEP;
+        for (uint64_t j = 0; j < size; j++) {
+            cjies[j] = shihou_to_cjie(shis[i + j]);
+        }
+        cjie_to_usec(cjies, usecs + i, size, set);
+    }
+}
+
+// `sui_to_futian` of `sui`s in [`sui`, `sui + num`), `xiazhi`s and
+// `liqiu`s of each chunk converted by one `cjie_to_usec`
+inline void sui_to_futian(
+    int16_t sui, futian *futs, uint64_t num, isa set = best_isa()
+) noexcept {
+    constexpr uint64_t STEP = 128;
+    int32_t cjies[2 * STEP];
+    int64_t usecs[2 * STEP];
+    for (uint64_t i = 0; i < num; i += STEP) {
+        uint64_t size = num - i < STEP ? num - i : STEP;
+        for (uint64_t j = 0; j < size; j++) {
+            int16_t suij = sui + int16_t(i + j);
+            cjies[2 * j] = shihou_to_cjie({suij, jieqi::xiazhi});
+            cjies[2 * j + 1] = shihou_to_cjie({suij, jieqi::liqiu});
+        }
+        cjie_to_usec(cjies, usecs, 2 * size, set);
+        for (uint64_t j = 0; j < size; j++) {
+            futs[i + j] = _bat::make_futian(usecs[2 * j], usecs[2 * j + 1]);
+        }
+    }
+}
+
+// `sui_to_shujiu` of `sui`s in [`sui`, `sui + num`)
+inline void sui_to_shujiu(
+    int16_t sui, shujiu *shus, uint64_t num, isa set = best_isa()
+) noexcept {
+    constexpr uint64_t STEP = 256;
+    int32_t cjies[STEP];
+    int64_t usecs[STEP];
+    for (uint64_t i = 0; i < num; i += STEP) {
+        uint64_t size = num - i < STEP ? num - i : STEP;
+        for (uint64_t j = 0; j < size; j++) {
+            int16_t suij = sui + int16_t(i + j);
+            cjies[j] = shihou_to_cjie({suij, jieqi::dongzhi});
+        }
+        cjie_to_usec(cjies, usecs, size, set);
+        for (uint64_t j = 0; j < size; j++) {
+            shus[i + j] = _bat::make_shujiu(usecs[j]);
+        }
+    }
+}
+
+} // namespace iw17::simd
+
+#endif // IW_SIMD_HPP
@@ -0,0 +1,29 @@
+# runs `nongli_annotate` on `annotate.txt` with an overlong line and an
+# unterminated one appended, against rows expected in `annotate.csv`
+#
+#   cmake -DEXE=... -DSRC=... -DOUT=... -P annotate.cmake
+
+file(READ "${SRC}/annotate.txt" text)
+set(long "9")
+foreach(i RANGE 12) # 8192 digits, over `LINE_CAP`
+    string(APPEND long "${long}")
+endforeach()
+string(APPEND text "${long}\n1733583364")
+file(WRITE "${OUT}/annotate.in" "${text}")
+
+execute_process(
+    COMMAND "${EXE}" --quiet "${OUT}/annotate.in"
+    OUTPUT_FILE "${OUT}/annotate.out"
+    RESULT_VARIABLE code
+)
+if(NOT code EQUAL 0)
+    message(FATAL_ERROR "nongli_annotate exited with ${code}")
+endif()
+execute_process(
+    COMMAND "${CMAKE_COMMAND}" -E compare_files
+        "${OUT}/annotate.out" "${SRC}/annotate.csv"
+    RESULT_VARIABLE diff
+)
+if(NOT diff EQUAL 0)
+    message(FATAL_ERROR "${OUT}/annotate.out differs from annotate.csv")
+endif()
@@ -0,0 +1,325 @@
+// annotates unix seconds or ISO datetimes, one per line, from stdin or
+// files, with `riqi`, `shihou`, zodiac, day `ganzhi` and `bazi` columns
+//
+//   nongli_annotate [--binary] [--lon=DEG] [--quiet] [FILE]...
+//
+// Only the first field of each line is read, up to a comma or a tab:
+//   -769381200, 1733583364
+//   2024-12-07T22:56:04, 2024-12-07 22:56:04+08:00, 1970-01-01T00:00Z
+// ISO datetimes without a zone are in UTC+8, and zones are within
+// 14:59 of UTC. Lines out of range or not parsed are kept in place,
+// with empty CSV fields or zeros in binary records, whose `usec` is
+// INT64_MIN.
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif // _WIN32
+
+#include "../nongli.hpp"
+
+namespace {
+
+using namespace iw17;
+
+constexpr uint64_t BLOCK = uint64_t(1) << 20; // bytes read at once
+constexpr uint64_t LINE_CAP = 4096; // longer lines not parsed
+constexpr uint64_t ROW_MAX = 128; // bytes of a CSV row at most
+
+struct record { // binary row, 24 bytes in native byte order
+    int64_t usec;
+    riqi rizi;
+    int16_t sui;
+    jieqi jie;
+    zodiac zod;
+    ganzhi rzhu; // of the civil day in UTC+8
+    int8_t pad[3];
+    bazi zhus; // in real solar time
+};
+
+static_assert(sizeof(record) == 24, "packed binary rows");
+
+// digits of `[beg, end)` into `val`, false if any not a digit
+inline bool read_uint(const char *beg, const char *end, int64_t &val) {
+    val = 0;
+    for (const char *p = beg; p < end; p++) {
+        uint32_t dig = uint32_t(*p) - '0';
+        if (dig > 9) {
+            return false;
+        }
+        val = 10 * val + dig;
+    }
+    return beg < end;
+}
+
+// `[+-]ddd...`
+inline bool parse_unix(const char *beg, const char *end, int64_t &usec) {
+    bool neg = (beg < end && *beg == '-');
+    beg += (beg < end && (*beg == '-' || *beg == '+'));
+    if (end - beg > 15 || !read_uint(beg, end, usec)) {
+        return false;
+    }
+    usec = neg ? -usec : usec;
+    return true;
+}
+
+// `YYYY-MM-DD[T ]hh:mm:ss[Z|+hh:mm|-hh:mm|+hhmm|-hhmm]`
+inline bool parse_iso(const char *beg, const char *end, int64_t &usec) {
+    uint64_t len = end - beg;
+    if (len < 19 || beg[4] != '-' || beg[7] != '-' || beg[13] != ':'
+        || beg[16] != ':' || (beg[10] != 'T' && beg[10] != ' ')) {
+        return false;
+    }
+    int64_t y, m, d, hh, mm, ss, zone = 8 * 3600;
+    if (!read_uint(beg, beg + 4, y) || !read_uint(beg + 5, beg + 7, m)
+        || !read_uint(beg + 8, beg + 10, d)
+        || !read_uint(beg + 11, beg + 13, hh)
+        || !read_uint(beg + 14, beg + 16, mm)
+        || !read_uint(beg + 17, beg + 19, ss)) {
+        return false;
+    }
+    const char *tz = beg + 19;
+    if (tz < end && *tz == 'Z') {
+        zone = 0, tz += 1;
+    } else if (tz < end && (*tz == '+' || *tz == '-')) {
+        bool colon = (end - tz == 6 && tz[3] == ':');
+        if (end - tz != 5 && !colon) {
+            return false;
+        }
+        int64_t zh, zm;
+        if (!read_uint(tz + 1, tz + 3, zh)
+            || !read_uint(tz + 3 + colon, tz + 5 + colon, zm)
+            || zh > 14 || zm > 59) {
+            return false;
+        }
+        zone = (*tz == '-' ? -60 : 60) * (60 * zh + zm);
+        tz = end;
+    }
+    date locd = {int16_t(y), int8_t(m), int8_t(d)};
+    if (tz != end || !check_date(locd) || hh > 23 || mm > 59 || ss > 59) {
+        return false;
+    }
+    int64_t dsec = 3600 * hh + 60 * mm + ss;
+    usec = int64_t(86400) * date_to_uday(locd) + dsec - zone;
+    return true;
+}
+
+inline char *put_int(char *out, int64_t val) {
+    char tmp[24];
+    uint64_t mag = (val < 0) ? 0 - uint64_t(val) : uint64_t(val);
+    int len = 0;
+    do {
+        tmp[len++] = char('0' + mag % 10);
+        mag /= 10;
+    } while (mag != 0);
+    *out = '-';
+    out += (val < 0);
+    while (len > 0) {
+        *out++ = tmp[--len];
+    }
+    return out;
+}
+
+struct annotator {
+
+bool binary = false;
+double lon = 120.0;
+int64_t usec_min = 0, usec_max = 0; // valid in [min, max)
+uint64_t rows = 0, bad = 0, bytes = 0;
+char *obuf = nullptr;
+uint64_t olen = 0;
+
+annotator() {
+    int32_t uday_min = cyue_to_uday(nian_to_cyue(NIAN_MIN));
+    int32_t uday_max = cyue_to_uday(nian_to_cyue(NIAN_MAX + 1));
+    usec_min = std::max(cjie_to_usec(CJIE_MIN), uday_to_usec(uday_min));
+    usec_max = std::min(cjie_to_usec(CJIE_MAX), uday_to_usec(uday_max));
+    obuf = static_cast<char *>(std::malloc(BLOCK));
+}
+
+annotator(const annotator &) = delete;
+
+~annotator() {
+    std::free(obuf);
+}
+
+bool flush() {
+    bool done = std::fwrite(obuf, 1, olen, stdout) == olen;
+    olen = 0;
+    return done;
+}
+
+void header() {
+    if (!binary) {
+        constexpr char HEAD[] = "usec,nian,ryue,tian,sui,jie,zodiac,"
+            "ganzhi,nzhu,yzhu,rzhu,szhu\n";
+        std::memcpy(obuf + olen, HEAD, sizeof(HEAD) - 1);
+        olen += sizeof(HEAD) - 1;
+    }
+}
+
+void row(const char *beg, const char *end) {
+    int64_t usec = 0;
+    bool good = (end - beg > 10 && beg[4] == '-')
+        ? parse_iso(beg, end, usec) : parse_unix(beg, end, usec);
+    good = good && usec >= usec_min && usec < usec_max;
+    rows += 1, bad += !good;
+    record rec = {};
+    rec.usec = INT64_MIN;
+    if (good) {
+        int32_t uday = usec_to_uday(usec);
+        shihou shi = usec_to_shihou(usec);
+        rec.usec = usec;
+        rec.rizi = uday_to_riqi(uday);
+        rec.sui = shi.sui, rec.jie = shi.jie;
+        rec.zod = jieqi_to_zodiac(shi.jie);
+        rec.rzhu = uday_to_ganzhi(uday);
+        rec.zhus = usec_to_bazi(usec, lon);
+    }
+    if (binary) {
+        std::memcpy(obuf + olen, &rec, sizeof(rec));
+        olen += sizeof(rec);
+    } else if (!good) {
+        constexpr char NONE[] = ",,,,,,,,,,,\n";
+        std::memcpy(obuf + olen, NONE, sizeof(NONE) - 1);
+        olen += sizeof(NONE) - 1;
+    } else {
+        char *out = obuf + olen;
+        const int64_t cols[] = {
+            rec.usec, rec.rizi.nian, rec.rizi.ryue, rec.rizi.tian,
+            rec.sui, int64_t(rec.jie), int64_t(rec.zod),
+            int64_t(rec.rzhu), int64_t(rec.zhus.zhu[0]),
+            int64_t(rec.zhus.zhu[1]), int64_t(rec.zhus.zhu[2]),
+            int64_t(rec.zhus.zhu[3]),
+        };
+        for (int64_t col: cols) {
+            out = put_int(out, col);
+            *out++ = ',';
+        }
+        out[-1] = '\n';
+        olen = out - obuf;
+    }
+}
+
+// lines of `fp` in blocks, no copies but partial lines at block ends
+bool feed(std::FILE *fp) {
+    static char ibuf[BLOCK + 1];
+    uint64_t keep = 0;
+    bool skip = false; // in a line longer than `LINE_CAP`
+    while (true) {
+        uint64_t got = std::fread(ibuf + keep, 1, BLOCK - keep, fp);
+        bytes += got;
+        bool last = (got == 0);
+        if (last && keep == 0) {
+            break;
+        }
+        char *beg = ibuf, *end = ibuf + keep + got;
+        if (last) {
+            *end++ = '\n'; // last line without newline
+        }
+        while (true) {
+            char *eol = static_cast<char *>(
+                std::memchr(beg, '\n', end - beg));
+            if (eol == nullptr) {
+                break;
+            }
+            if (skip) { // kept in place as invalid
+                skip = false;
+                this->row(eol, eol);
+            } else {
+                char *stop = beg;
+                while (stop < eol && *stop != ',' && *stop != '\t'
+                    && *stop != '\r') {
+                    stop++;
+                }
+                while (stop > beg && stop[-1] == ' ') {
+                    stop--;
+                }
+                this->row(beg, stop);
+            }
+            beg = eol + 1;
+            if (olen > BLOCK - ROW_MAX && !this->flush()) {
+                return false;
+            }
+        }
+        keep = end - beg;
+        if (keep > LINE_CAP) {
+            skip = true, keep = 0;
+        }
+        std::memmove(ibuf, beg, keep);
+        if (last) {
+            break;
+        }
+    }
+    return std::ferror(fp) == 0;
+}
+
+}; // struct annotator
+
+} // namespace
+
+int main(int argc, char **argv) {
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif // _WIN32
+    static annotator ann;
+    bool quiet = false;
+    int nfile = 0;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (std::strcmp(arg, "--binary") == 0) {
+            ann.binary = true;
+        } else if (std::strncmp(arg, "--lon=", 6) == 0) {
+            ann.lon = std::atof(arg + 6);
+        } else if (std::strcmp(arg, "--quiet") == 0) {
+            quiet = true;
+        } else if (arg[0] == '-' && arg[1] == '-') {
+            std::fprintf(stderr, "Unknown option %s\n", arg);
+            return 2;
+        } else {
+            nfile += 1;
+        }
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    ann.header();
+    bool good = true;
+    for (int i = 1; good && i < argc; i++) {
+        const char *arg = argv[i];
+        if (arg[0] == '-' && arg[1] == '-') {
+            continue;
+        }
+        bool std_in = std::strcmp(arg, "-") == 0;
+        std::FILE *fp = std_in ? stdin : std::fopen(arg, "rb");
+        if (fp == nullptr) {
+            std::fprintf(stderr, "Cannot read from %s\n", arg);
+            return 1;
+        }
+        good = ann.feed(fp);
+        if (!std_in) {
+            std::fclose(fp);
+        }
+    }
+    good = (nfile > 0 || ann.feed(stdin)) && good;
+    good = ann.flush() && std::fflush(stdout) == 0 && good;
+    auto t1 = std::chrono::steady_clock::now();
+    double secs = std::chrono::duration<double>(t1 - t0).count();
+    if (!quiet) {
+        std::fprintf(stderr, "%" PRIu64 " rows (%" PRIu64 " invalid) "
+            "in %.3f s: %.1f M rows/min, %.1f MB/s\n",
+            ann.rows, ann.bad, secs, ann.rows / secs * 60e-6,
+            ann.bytes / secs * 1e-6
+        );
+    }
+    if (!good) {
+        std::fprintf(stderr, "Failed on I/O\n");
+    }
+    return good ? 0 : 1;
+}
@@ -0,0 +1,596 @@
+#include <random>
+
+#include "../hanzi.hpp"
+#include "../iso.hpp"
+#include "../nongli.hpp"
+#include "../parallel.hpp"
+#include "../range.hpp"
+#include "../simd.hpp"
+#include "bench.hpp"
+
+using tz = iw17::tzinfo;
+using ks = std::vector<int64_t>;
+
+constexpr uint64_t N = 4096; // inputs per distribution
+
+constexpr const char *DISTS[] = {
+    "random", "sequential", "boundary",
+};
+
+struct keys { // integral keys, mapped to arguments later
+    ks dist[3];
+};
+
+// random in `[lo, hi]`, `lo` onwards by `step`, around `edges`
+keys make_keys(int64_t lo, int64_t hi, int64_t step, const ks &edges) {
+    std::mt19937_64 gen(20251016);
+    std::uniform_int_distribution<int64_t> uni(lo, hi);
+    keys kk;
+    for (uint64_t i = 0; i < N; i++) {
+        kk.dist[0].push_back(uni(gen));
+        int64_t seq = lo + int64_t(i) * step;
+        kk.dist[1].push_back(lo + (seq - lo) % (hi - lo + 1));
+        int64_t edge = edges[i / 3 % edges.size()] + int64_t(i % 3) - 1;
+        kk.dist[2].push_back(std::clamp(edge, lo, hi));
+    }
+    return kk;
+}
+
+template <class Ret, class... Args, class Make>
+void bench_keys(iw17::bench_suite &suite, const char *name,
+    Ret (*func)(Args...), const keys &kk, Make make
+) {
+    for (int d = 0; d < 3; d++) {
+        std::vector<std::tuple<Args...>> ins;
+        for (int64_t k: kk.dist[d]) {
+            ins.push_back(make(k));
+        }
+        suite.bench(name, DISTS[d], func, ins);
+    }
+}
+
+template <class Out, class In, class Func, class Make>
+void bulk_keys(iw17::bench_suite &suite, const char *name,
+    Func func, const keys &kk, Make make
+) {
+    for (int d = 0; d < 3; d++) {
+        std::vector<In> ins;
+        for (int64_t k: kk.dist[d]) {
+            ins.push_back(make(k));
+        }
+        suite.bulk<Out>(name, DISTS[d], func, ins);
+    }
+}
+
+// random inputs, with `spans` in cache and out of cache
+template <class Ret, class Arg, class Make>
+void bench_cache(iw17::bench_suite &suite, const char *name,
+    Ret (*func)(Arg), const keys &kk, Make make,
+    const std::vector<iw17::bench_span> &spans
+) {
+    std::vector<std::tuple<Arg>> ins;
+    for (int64_t k: kk.dist[0]) {
+        ins.push_back(std::tuple<Arg>(make(k)));
+    }
+    suite.bench(name, "hot", func, ins);
+    suite.evicts = spans;
+    suite.bench(name, "cold", func, ins);
+    suite.evicts.clear();
+}
+
+int main(int argc, char **argv) {
+    using namespace iw17;
+    using trim::NIAN_MIN, trim::NIAN_MAX;
+    using trim::SUI_MIN, trim::SUI_MAX;
+    using trim::CJIE_MIN, trim::CJIE_MAX;
+    const int32_t cyue_min = nian_to_cyue(NIAN_MIN);
+    const int32_t cyue_max = nian_to_cyue(NIAN_MAX + 1) - 1;
+    const int32_t uday_min = cyue_to_uday(cyue_min);
+    const int32_t uday_max = cyue_to_uday(cyue_max + 1) - 1;
+    const int64_t usec_min = cjie_to_usec(CJIE_MIN);
+    const int64_t usec_max = cjie_to_usec(CJIE_MAX) - 1;
+    ks nian_edges = {NIAN_MIN, NIAN_MIN + 1, NIAN_MAX - 1, NIAN_MAX};
+    for (int16_t nian = NIAN_MIN; nian <= NIAN_MAX; nian++) {
+        if (nian_to_run(nian) != 0) {
+            nian_edges.push_back(nian);
+        }
+    }
+    ks cyue_edges, uday_edges, cjie_edges, usec_edges;
+    for (int16_t nian = NIAN_MIN; nian <= NIAN_MAX; nian++) {
+        cyue_edges.push_back(nian_to_cyue(nian));
+    }
+    for (int32_t cyue = cyue_min; cyue <= cyue_max; cyue++) {
+        uday_edges.push_back(cyue_to_uday(cyue));
+    }
+    for (int32_t cjie = CJIE_MIN; cjie <= CJIE_MAX; cjie += 24) {
+        cjie_edges.push_back(cjie);
+    }
+    for (int32_t cjie = CJIE_MIN + 1; cjie < CJIE_MAX; cjie++) {
+        usec_edges.push_back(cjie_to_usec(cjie));
+    }
+    const keys nians = make_keys(NIAN_MIN, NIAN_MAX, 1, nian_edges);
+    const keys suis = make_keys(SUI_MIN, SUI_MAX, 1, nian_edges);
+    const keys cyues = make_keys(cyue_min, cyue_max, 1, cyue_edges);
+    const keys udays = make_keys(uday_min, uday_max, 1, uday_edges);
+    const keys cjies = make_keys(CJIE_MIN, CJIE_MAX, 1, cjie_edges);
+    const keys usecs = make_keys(usec_min, usec_max, 3600, usec_edges);
+    auto to_uday = [](int64_t k) { return int32_t(k); };
+    auto to_date = [](int64_t k) { return uday_to_date(k); };
+    auto to_riqi = [](int64_t k) { return uday_to_riqi(k); };
+    auto to_dati = [](int64_t k) {
+        return usec_to_dati(k, tz::east_0800);
+    };
+    auto to_shihou = [](int64_t k) { return cjie_to_shihou(k); };
+    auto to_ganzhi = [](int64_t k) { return ganzhi(k % 60); };
+    std::vector<int64_t> hours(1 << 18);
+    for (uint64_t i = 0; i < hours.size(); i++) {
+        hours[i] = uday_to_usec(uday_min) + 3600 * int64_t(i);
+    }
+    std::vector<shihou> shis(hours.size());
+    std::vector<bazi> bazis(hours.size());
+    std::vector<riqi> rizis(hours.size());
+    bench_suite suite(argc, argv);
+    for (uint64_t rep = 0; rep < suite.repeats; rep++) {
+        // dati.hpp
+        bench_keys(suite, "check_date", check_date, udays,
+            [&](int64_t k) { return std::tuple(to_date(k)); });
+        bench_keys(suite, "date_to_uday", date_to_uday, udays,
+            [&](int64_t k) { return std::tuple(to_date(k)); });
+        bench_keys(suite, "uday_to_date", uday_to_date, udays,
+            [&](int64_t k) { return std::tuple(to_uday(k)); });
+        bench_keys(suite, "_ref::date_to_uday", _ref::date_to_uday, udays,
+            [&](int64_t k) { return std::tuple(to_date(k)); });
+        bench_keys(suite, "_ref::uday_to_date", _ref::uday_to_date, udays,
+            [&](int64_t k) { return std::tuple(to_uday(k)); });
+        bench_keys(suite, "zone_to_offset", zone_to_offset, udays,
+            [&](int64_t k) { return std::tuple(tz(k % 105)); });
+        bench_keys(suite, "check_dati", check_dati, usecs,
+            [&](int64_t k) { return std::tuple(to_dati(k)); });
+        bench_keys(suite, "dati_to_date", dati_to_date, usecs,
+            [&](int64_t k) { return std::tuple(to_dati(k)); });
+        bench_keys(suite, "dati_to_usec", dati_to_usec, usecs,
+            [&](int64_t k) { return std::tuple(to_dati(k)); });
+        bench_keys(suite, "usec_to_dati", usec_to_dati, usecs,
+            [&](int64_t k) { return std::tuple(k, tz::east_0800); });
+        bench_keys(suite, "zone_cast", zone_cast, usecs,
+            [&](int64_t k) { return std::tuple(to_dati(k), tz::utc); });
+        // math.hpp: series against table trigonometry
+        auto to_fix = [](int64_t k) {
+            return std::tuple(math::fill_fix64(k * 1193));
+        };
+        bench_keys(suite, "math::sinq", math::sinq, usecs, to_fix);
+        bench_keys(suite, "math::cosq", math::cosq, usecs, to_fix);
+        bench_keys(suite, "math::_lut::sinq", math::_lut::sinq, usecs,
+            to_fix);
+        bench_keys(suite, "math::_lut::cosq", math::_lut::cosq, usecs,
+            to_fix);
+        // nongli.hpp: lunar calendar
+        bench_keys(suite, "uday_to_usec", uday_to_usec, udays,
+            [&](int64_t k) { return std::tuple(to_uday(k)); });
+        bench_keys(suite, "usec_to_uday", usec_to_uday, usecs,
+            [&](int64_t k) { return std::tuple(k); });
+        bench_keys(suite, "ryue_to_nyue", ryue_to_nyue, cyues,
+            [&](int64_t k) {
+                riqi rizi = uday_to_riqi(cyue_to_uday(k));
+                int8_t run = nian_to_run(rizi.nian);
+                return std::tuple(rizi.ryue, run);
+            });
+        bench_keys(suite, "nyue_to_ryue", nyue_to_ryue, cyues,
+            [&](int64_t k) {
+                int16_t nian = cyue_to_nian(k);
+                int8_t nyue = k - nian_to_cyue(nian) + 1;
+                return std::tuple(nyue, nian_to_run(nian));
+            });
+        bench_keys(suite, "nian_to_run", nian_to_run, nians,
+            [&](int64_t k) { return std::tuple(int16_t(k)); });
+        bench_keys(suite, "nian_to_cyue", nian_to_cyue, nians,
+            [&](int64_t k) { return std::tuple(int16_t(k)); });
+        bench_keys(suite, "cyue_to_uday", cyue_to_uday, cyues,
+            [&](int64_t k) { return std::tuple(int32_t(k)); });
+        bench_keys(suite, "days_in_cyue", days_in_cyue, cyues,
+            [&](int64_t k) { return std::tuple(int32_t(k)); });
+        bench_keys(suite, "riqi_to_hui", riqi_to_hui, udays,
+            [&](int64_t k) { return std::tuple(to_riqi(k)); });
+        bench_keys(suite, "check_riqi", check_riqi, udays,
+            [&](int64_t k) { return std::tuple(to_riqi(k)); });
+        bench_keys(suite, "uday_to_cyue", uday_to_cyue, udays,
+            [&](int64_t k) { return std::tuple(to_uday(k)); });
+        bench_keys(suite, "cyue_to_nian", cyue_to_nian, cyues,
+            [&](int64_t k) { return std::tuple(int32_t(k)); });
+        bench_keys(suite, "uday_to_riqi", uday_to_riqi, udays,
+            [&](int64_t k) { return std::tuple(to_uday(k)); });
+        bench_keys(suite, "date_to_riqi", date_to_riqi, udays,
+            [&](int64_t k) { return std::tuple(to_date(k)); });
+        bench_keys(suite, "riqi_to_uday", riqi_to_uday, udays,
+            [&](int64_t k) { return std::tuple(to_riqi(k)); });
+        bench_keys(suite, "riqi_to_date", riqi_to_date, udays,
+            [&](int64_t k) { return std::tuple(to_riqi(k)); });
+        bench_keys(suite, "next_nian", next_nian, udays,
+            [&](int64_t k) { return std::tuple(to_riqi(k), int16_t(1)); });
+        bench_keys(suite, "next_cyue", next_cyue, udays,
+            [&](int64_t k) { return std::tuple(to_riqi(k), int32_t(1)); });
+        bench_keys(suite, "next_tian", next_tian, udays,
+            [&](int64_t k) { return std::tuple(to_riqi(k), int32_t(1)); });
+        bulk_keys<riqi, int32_t>(suite, "batch::uday_to_riqi",
+            batch::uday_to_riqi, udays, to_uday);
+        bulk_keys<int32_t, riqi>(suite, "batch::riqi_to_uday",
+            batch::riqi_to_uday, udays, to_riqi);
+        // nongli.hpp: solar terms
+        bench_keys(suite, "shihou_to_cjie", shihou_to_cjie, cjies,
+            [&](int64_t k) { return std::tuple(to_shihou(k)); });
+        bench_keys(suite, "cjie_to_shihou", cjie_to_shihou, cjies,
+            [&](int64_t k) { return std::tuple(int32_t(k)); });
+        bench_keys(suite, "shihou_to_usec", shihou_to_usec, cjies,
+            [&](int64_t k) { return std::tuple(to_shihou(k)); });
+        bench_keys(suite, "shihou_to_dati", shihou_to_dati, cjies,
+            [&](int64_t k) { return std::tuple(to_shihou(k)); });
+        bench_keys(suite, "cjie_to_usec", cjie_to_usec, cjies,
+            [&](int64_t k) { return std::tuple(int32_t(k)); });
+        bench_keys(suite, "cjie_to_dati", cjie_to_dati, cjies,
+            [&](int64_t k) { return std::tuple(int32_t(k)); });
+        bench_keys(suite, "usec_to_cjie", usec_to_cjie, usecs,
+            [&](int64_t k) { return std::tuple(k); });
+        bench_keys(suite, "dati_to_cjie", dati_to_cjie, usecs,
+            [&](int64_t k) { return std::tuple(to_dati(k)); });
+        bench_keys(suite, "usec_to_shihou", usec_to_shihou, usecs,
+            [&](int64_t k) { return std::tuple(k); });
+        bench_keys(suite, "dati_to_shihou", dati_to_shihou, usecs,
+            [&](int64_t k) { return std::tuple(to_dati(k)); });
+        bench_keys(suite, "jieqi_to_zodiac", jieqi_to_zodiac, cjies,
+            [&](int64_t k) { return std::tuple(to_shihou(k).jie); });
+        bench_keys(suite, "usec_to_zodiac", usec_to_zodiac, usecs,
+            [&](int64_t k) { return std::tuple(k); });
+        bench_keys(suite, "dati_to_zodiac", dati_to_zodiac, usecs,
+            [&](int64_t k) { return std::tuple(to_dati(k)); });
+        // nongli.hpp: ganzhi and bazi
+        bench_keys(suite, "ganzhi_to_tiangan", ganzhi_to_tiangan, udays,
+            [&](int64_t k) { return std::tuple(to_ganzhi(k)); });
+        bench_keys(suite, "ganzhi_to_dizhi", ganzhi_to_dizhi, udays,
+            [&](int64_t k) { return std::tuple(to_ganzhi(k)); });
+        bench_keys(suite, "make_ganzhi", make_ganzhi, udays,
+            [&](int64_t k) {
+                ganzhi zhu = to_ganzhi(k);
+                return std::tuple(ganzhi_to_tiangan(zhu),
+                    ganzhi_to_dizhi(zhu));
+            });
+        bench_keys(suite, "nian_to_ganzhi", nian_to_ganzhi, nians,
+            [&](int64_t k) { return std::tuple(int16_t(k)); });
+        bench_keys(suite, "uday_to_ganzhi", uday_to_ganzhi, udays,
+            [&](int64_t k) { return std::tuple(to_uday(k)); });
+        bench_keys(suite, "riqi_to_ganzhi", riqi_to_ganzhi, udays,
+            [&](int64_t k) { return std::tuple(to_riqi(k)); });
+        bench_keys(suite, "ganzhi_to_riqi", ganzhi_to_riqi, udays,
+            [&](int64_t k) {
+                return std::tuple(to_riqi(k), to_ganzhi(k));
+            });
+        bench_keys(suite, "byue_to_ganzhi", byue_to_ganzhi, cyues,
+            [&](int64_t k) { return std::tuple(int32_t(k)); });
+        bench_keys(suite, "bday_to_ganzhi", bday_to_ganzhi, udays,
+            [&](int64_t k) { return std::tuple(to_uday(k)); });
+        bench_keys(suite, "bshi_to_ganzhi", bshi_to_ganzhi, usecs,
+            [&](int64_t k) { return std::tuple(k / 7200); });
+        bench_keys(suite, "sui_to_toufu", sui_to_toufu, suis,
+            [&](int64_t k) { return std::tuple(int16_t(k)); });
+        bench_keys(suite, "sui_to_sanfu", sui_to_sanfu, suis,
+            [&](int64_t k) { return std::tuple(int16_t(k)); });
+        bench_keys(suite, "sui_to_futian", sui_to_futian, suis,
+            [&](int64_t k) { return std::tuple(int16_t(k)); });
+        bench_keys(suite, "sui_to_shujiu", sui_to_shujiu, suis,
+            [&](int64_t k) { return std::tuple(int16_t(k)); });
+        bench_keys(suite, "usec_to_bazi", usec_to_bazi, usecs,
+            [&](int64_t k) { return std::tuple(k, 116.4); });
+        bench_keys(suite, "dati_to_bazi", dati_to_bazi, usecs,
+            [&](int64_t k) { return std::tuple(to_dati(k), 116.4); });
+        auto to_usec = [](int64_t k) { return k; };
+        bulk_keys<shihou, int64_t>(suite, "batch::usec_to_shihou",
+            batch::usec_to_shihou, usecs, to_usec);
+        bulk_keys<bazi, int64_t>(suite, "batch::usec_to_bazi",
+            [](const int64_t *ins, bazi *outs, uint64_t num) {
+                batch::usec_to_bazi(ins, outs, num, 116.4);
+            }, usecs, to_usec);
+        bulk_keys<riqi, int64_t>(suite, "batch::usec_to_riqi",
+            batch::usec_to_riqi, udays,
+            [](int64_t k) { return uday_to_usec(k) + 43200; });
+        // backends: fittings against dense tables
+        const std::vector<bench_span> ny_fit = {
+            {data::NY_COEF, sizeof(data::NY_COEF)},
+            {data::NY_RESY, sizeof(data::NY_RESY)},
+        };
+        const std::vector<bench_span> ny_tab = {
+            {&_tab::NY_DENSE<>, sizeof(_tab::NY_DENSE<>)},
+        };
+        const std::vector<bench_span> yd_fit = {
+            {data::YD_COEF, sizeof(data::YD_COEF)},
+            {data::YD_RESD_0, sizeof(data::YD_RESD_0)},
+        };
+        const std::vector<bench_span> yd_tab = {
+            {&_tab::YD_DENSE<>, sizeof(_tab::YD_DENSE<>)},
+        };
+        auto to_nian = [](int64_t k) { return int16_t(k); };
+        bench_cache(suite, "_fit::nian_to_cyue",
+            _fit::nian_to_cyue, nians, to_nian, ny_fit);
+        bench_cache(suite, "_tab::nian_to_cyue",
+            _tab::nian_to_cyue, nians, to_nian, ny_tab);
+        bench_cache(suite, "_fit::cyue_to_uday",
+            _fit::cyue_to_uday, cyues, to_uday, yd_fit);
+        bench_cache(suite, "_tab::cyue_to_uday",
+            _tab::cyue_to_uday, cyues, to_uday, yd_tab);
+        bench_keys(suite, "_tab::uday_to_riqi", _tab::uday_to_riqi, udays,
+            [&](int64_t k) { return std::tuple(to_uday(k)); });
+        // `nian` summaries, stepping back from the last `nian`
+        auto to_step = [](riqi rizi) { return rizi.nian < NIAN_MAX; };
+        bench_keys(suite, "_tab::riqi_to_hui", _tab::riqi_to_hui, udays,
+            [&](int64_t k) { return std::tuple(to_riqi(k)); });
+        bench_keys(suite, "_tab::check_riqi", _tab::check_riqi, udays,
+            [&](int64_t k) { return std::tuple(to_riqi(k)); });
+        bench_keys(suite, "_tab::riqi_to_uday", _tab::riqi_to_uday, udays,
+            [&](int64_t k) { return std::tuple(to_riqi(k)); });
+        bench_keys(suite, "_tab::usec_to_cjie", _tab::usec_to_cjie, usecs,
+            [&](int64_t k) { return std::tuple(k); });
+        bench_keys(suite, "_tab::usec_to_bazi", _tab::usec_to_bazi, usecs,
+            [&](int64_t k) { return std::tuple(k, 116.4); });
+        bench_keys(suite, "_tab::next_nian", _tab::next_nian, udays,
+            [&](int64_t k) {
+                riqi rizi = to_riqi(k);
+                return std::tuple(rizi, int16_t(to_step(rizi) ? 1 : -1));
+            });
+        bench_keys(suite, "_tab::next_cyue", _tab::next_cyue, udays,
+            [&](int64_t k) {
+                riqi rizi = to_riqi(k);
+                return std::tuple(rizi, int32_t(to_step(rizi) ? 1 : -1));
+            });
+        // walks over all days, one op per day
+        const uint64_t ndays = uday_max - uday_min + 1;
+        suite.measure("next_tian", "walk", ndays,
+            [=](uint64_t beg, uint64_t end) {
+                riqi rizi = uday_to_riqi(uday_min + beg);
+                int64_t sum = 0;
+                for (uint64_t i = beg; i < end; i++) {
+                    sum += rizi.ryue + rizi.tian;
+                    rizi = next_tian(rizi, 1);
+                }
+                keep_alive(sum);
+            });
+        suite.measure("riqi_range", "walk", ndays,
+            [=](uint64_t beg, uint64_t end) {
+                riqi_range span = {
+                    int32_t(uday_min + beg), int32_t(uday_min + end - 1),
+                };
+                int64_t sum = 0;
+                for (tian_info info: span) {
+                    sum += info.rizi.ryue + info.rizi.tian;
+                    sum += info.locd.day + int64_t(info.zhu);
+                    sum += int64_t(info.jie) + info.jiao;
+                }
+                keep_alive(sum);
+            });
+        // consecutive keys, stepped instead of fitted one by one
+        const uint64_t nyues = cyue_max + 2 - cyue_min;
+        std::vector<int32_t> yud01s(nyues);
+        suite.measure("batch::cyue_to_uday", "walk", nyues,
+            [&](uint64_t beg, uint64_t end) {
+                batch::cyue_to_uday(int32_t(cyue_min + beg),
+                    yud01s.data() + beg, end - beg);
+                keep_alive(yud01s[end - 1]);
+            });
+        const uint64_t njies = CJIE_MAX + 1 - CJIE_MIN;
+        std::vector<int64_t> jquss(njies);
+        suite.measure("batch::cjie_to_usec", "walk", njies,
+            [&](uint64_t beg, uint64_t end) {
+                batch::cjie_to_usec(int32_t(CJIE_MIN + beg),
+                    jquss.data() + beg, end - beg);
+                keep_alive(jquss[end - 1]);
+            });
+        // birthdays of a user base over a century, one op per birth
+        std::vector<riqi> births;
+        for (int32_t uday = uday_min; uday <= uday_max; uday += 7) {
+            births.push_back(uday_to_riqi(uday));
+        }
+        const int16_t span = (NIAN_MAX + 1 - NIAN_MIN < 100)
+            ? NIAN_MAX + 1 - NIAN_MIN : 100;
+        std::vector<date> srds(births.size() * span);
+        suite.measure("shengri", "x100", births.size(),
+            [&](uint64_t beg, uint64_t end) {
+                for (uint64_t i = beg; i < end; i++) {
+                    for (int16_t k = 0; k < span; k++) {
+                        riqi rizi = shengri(births[i], NIAN_MIN + k);
+                        srds[i * span + k] = riqi_to_date(rizi);
+                    }
+                }
+                keep_alive(srds[end * span - 1]);
+            });
+        suite.measure("batch::shengri", "x100", births.size(),
+            [&](uint64_t beg, uint64_t end) {
+                batch::shengri(births.data() + beg,
+                    srds.data() + beg * span, end - beg, NIAN_MIN, span);
+                keep_alive(srds[end * span - 1]);
+            });
+        // spans of `sui`s, `jie`s of each chunk in one pass
+        const uint64_t nsuis = SUI_MAX + 1 - SUI_MIN;
+        std::vector<futian> futs(nsuis);
+        std::vector<shujiu> shus(nsuis);
+        suite.measure("batch::sui_to_futian", "walk", nsuis,
+            [&](uint64_t beg, uint64_t end) {
+                batch::sui_to_futian(int16_t(SUI_MIN + beg),
+                    futs.data() + beg, end - beg);
+                keep_alive(futs[end - 1].udnx);
+            });
+        suite.measure("simd::sui_to_futian", "walk", nsuis,
+            [&](uint64_t beg, uint64_t end) {
+                simd::sui_to_futian(int16_t(SUI_MIN + beg),
+                    futs.data() + beg, end - beg);
+                keep_alive(futs[end - 1].udnx);
+            });
+        suite.measure("simd::sui_to_shujiu", "walk", nsuis,
+            [&](uint64_t beg, uint64_t end) {
+                simd::sui_to_shujiu(int16_t(SUI_MIN + beg),
+                    shus.data() + beg, end - beg);
+                keep_alive(shus[end - 1].jius[9]);
+            });
+        // columns of all days, to dates and back, per instruction set
+        std::vector<int32_t> coluds(ndays);
+        std::vector<date> colds(ndays);
+        for (uint64_t i = 0; i < ndays; i++) {
+            coluds[i] = int32_t(uday_min + i);
+        }
+        for (simd::isa set: {simd::isa::scalar, simd::best_isa()}) {
+            const char *dist = (set == simd::isa::scalar)
+                ? "scalar" : "best";
+            suite.measure("simd::uday_to_date", dist, ndays,
+                [&](uint64_t beg, uint64_t end) {
+                    simd::uday_to_date(coluds.data() + beg,
+                        colds.data() + beg, end - beg, set);
+                    keep_alive(colds[end - 1]);
+                });
+            suite.measure("simd::date_to_uday", dist, ndays,
+                [&](uint64_t beg, uint64_t end) {
+                    simd::date_to_uday(colds.data() + beg,
+                        coluds.data() + beg, end - beg, set);
+                    keep_alive(coluds[end - 1]);
+                });
+        }
+        // ISO 8601 lines, hourly on all zones, against the C library
+        const uint64_t line = ISO_LEN + 1;
+        std::vector<dati> zonds(hours.size());
+        for (uint64_t i = 0; i < hours.size(); i++) {
+            zonds[i] = usec_to_dati(hours[i], tz(i % 105));
+        }
+        std::vector<char> text(hours.size() * line);
+        batch::format_dati(zonds.data(), text.data(), zonds.size());
+        suite.measure("batch::parse_dati", "lines", zonds.size(),
+            [&](uint64_t beg, uint64_t end) {
+                const char *str = text.data();
+                batch::parse_dati(str + beg * line, str + end * line,
+                    zonds.data() + beg, end - beg);
+                keep_alive(zonds[end - 1]);
+            });
+        suite.measure("std::sscanf", "lines", zonds.size(),
+            [&](uint64_t beg, uint64_t end) {
+                for (uint64_t i = beg; i < end; i++) {
+                    int y, m, d, hh, mm, ss, zh, zm;
+                    char sign, str[ISO_LEN + 1] = ""; // NUL-terminated
+                    std::memcpy(str, text.data() + i * line, ISO_LEN);
+                    std::sscanf(str, "%4d-%2d-%2dT%2d:%2d:%2d%c%2d:%2d",
+                        &y, &m, &d, &hh, &mm, &ss, &sign, &zh, &zm);
+                    int quar = (sign == '-' ? -1 : 1) * (4 * zh + zm / 15);
+                    zonds[i] = dati{int16_t(y), int8_t(m), int8_t(d),
+                        int8_t(hh), int8_t(mm), int8_t(ss),
+                        tz(int(tz::utc) + quar)};
+                }
+                keep_alive(zonds[end - 1]);
+            });
+        suite.measure("batch::format_dati", "lines", zonds.size(),
+            [&](uint64_t beg, uint64_t end) {
+                batch::format_dati(zonds.data() + beg,
+                    text.data() + beg * line, end - beg);
+                keep_alive(text[end * line - 1]);
+            });
+        suite.measure("std::strftime", "lines", zonds.size(),
+            [&](uint64_t beg, uint64_t end) {
+                for (uint64_t i = beg; i < end; i++) {
+                    auto [y, m, d, hh, mm, ss, zone] = zonds[i];
+                    std::tm stm = {};
+                    stm.tm_year = y - 1900, stm.tm_mon = m - 1;
+                    stm.tm_mday = d, stm.tm_hour = hh;
+                    stm.tm_min = mm, stm.tm_sec = ss;
+                    char *str = text.data() + i * line;
+                    uint64_t len = std::strftime(str, line,
+                        "%Y-%m-%dT%H:%M:%S", &stm);
+                    int quar = int(zone) - int(tz::utc);
+                    int zabs = quar < 0 ? -quar : quar;
+                    std::snprintf(str + len, line - len, "%c%02d:%02d",
+                        quar < 0 ? '-' : '+', zabs / 4, 15 * (zabs % 4));
+                    str[line - 1] = '\n';
+                }
+                keep_alive(text[end * line - 1]);
+            });
+        // pages in hanzi over all days, into a buffer reused by chunks
+        std::vector<char> pages(ndays * hanzi::batch::LINE_MAX);
+        suite.measure("hanzi::batch::format_days", "walk", ndays,
+            [&](uint64_t beg, uint64_t end) {
+                char *str = pages.data() + beg * hanzi::batch::LINE_MAX;
+                str = hanzi::batch::format_days(
+                    int32_t(uday_min + beg), str, end - beg);
+                keep_alive(str[-1]);
+            });
+        // lines of `riqi`s in hanzi over all days, and back
+        std::string hzs;
+        for (uint64_t i = 0; i < ndays; i++) {
+            riqi rizi = uday_to_riqi(int32_t(uday_min + i));
+            char buf[hanzi::RIQI_MAX];
+            char *mid = hanzi::_hz::put_digits(buf, uint32_t(rizi.nian));
+            char *last = hanzi::format_riqi(rizi, mid);
+            hzs.append(buf, mid).append(mid + 6, last).push_back('\n');
+        }
+        std::vector<uint64_t> eols(ndays + 1); // line `i` ends at `i + 1`
+        for (uint64_t i = 0, j = 0; i < hzs.size(); i++) {
+            eols[j + 1] = i + 1;
+            j += hzs[i] == '\n';
+        }
+        std::vector<riqi> hrizis(ndays);
+        std::vector<hanzi::status> hstats(ndays);
+        suite.measure("hanzi::batch::parse_riqi", "lines", ndays,
+            [&](uint64_t beg, uint64_t end) {
+                const char *str = hzs.data();
+                hanzi::batch::parse_riqi(str + eols[beg], str + eols[end],
+                    hrizis.data() + beg, hstats.data() + beg, end - beg);
+                keep_alive(hrizis[end - 1]);
+            });
+        // names of `jieqi`, by perfect hash against linear search
+        const uint64_t njqs = 24 * 1024;
+        suite.measure("hanzi::parse_jieqi", "names", njqs,
+            [&](uint64_t beg, uint64_t end) {
+                int64_t sum = 0;
+                for (uint64_t i = beg; i < end; i++) {
+                    jieqi jie = jieqi::dongzhi;
+                    hanzi::parse_jieqi(hanzi::JIEQI[i * 7 % 24], jie);
+                    sum += int64_t(jie);
+                }
+                keep_alive(sum);
+            });
+        suite.measure("linear::parse_jieqi", "names", njqs,
+            [&](uint64_t beg, uint64_t end) {
+                int64_t sum = 0;
+                for (uint64_t i = beg; i < end; i++) {
+                    std::string_view name = hanzi::JIEQI[i * 7 % 24];
+                    int64_t k = 0;
+                    while (k < 24 && hanzi::JIEQI[k] != name) {
+                        k++;
+                    }
+                    sum += k;
+                }
+                keep_alive(sum);
+            });
+        // scaling: sorted usecs, hourly, split over threads
+        for (unsigned nthr: {1u, 2u, 4u, 8u}) {
+            parallel::pool exec(nthr);
+            char dist[16] = "";
+            std::snprintf(dist, sizeof(dist), "threads_%u", nthr);
+            auto run_bulk = [&](const char *name, auto func) {
+                suite.measure(name, dist, hours.size(),
+                    [&](uint64_t beg, uint64_t end) {
+                        func(exec, beg, end);
+                    });
+            };
+            run_bulk("parallel::usec_to_shihou",
+                [&](parallel::pool &ex, uint64_t beg, uint64_t end) {
+                    parallel::usec_to_shihou(ex, hours.data() + beg,
+                        shis.data() + beg, end - beg);
+                    keep_alive(shis[end - 1]);
+                });
+            run_bulk("parallel::usec_to_bazi",
+                [&](parallel::pool &ex, uint64_t beg, uint64_t end) {
+                    parallel::usec_to_bazi(ex, hours.data() + beg,
+                        bazis.data() + beg, end - beg, 116.4);
+                    keep_alive(bazis[end - 1]);
+                });
+            run_bulk("parallel::usec_to_riqi",
+                [&](parallel::pool &ex, uint64_t beg, uint64_t end) {
+                    parallel::usec_to_riqi(ex, hours.data() + beg,
+                        rizis.data() + beg, end - beg);
+                    keep_alive(rizis[end - 1]);
+                });
+        }
+    }
+    return suite.complete();
+}
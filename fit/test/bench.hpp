@@ -0,0 +1,350 @@
+#ifndef IW_BENCH_HPP
+#define IW_BENCH_HPP 20251016L
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif // _MSC_VER
+
+#if defined(__x86_64__) || defined(_M_X64) || \
+    defined(__i386__) || defined(_M_IX86)
+#include <emmintrin.h>
+#define IW_BENCH_CLFLUSH 1
+#else // x86
+#define IW_BENCH_CLFLUSH 0
+#endif // x86
+
+namespace iw17 {
+
+// keeps `val` observable, so that its computation is not elided
+template <class T>
+inline void keep_alive(const T &val) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    static const volatile void *sink = nullptr;
+    sink = &val;
+    _ReadWriteBarrier();
+#else // _MSC_VER
+    asm volatile("" : : "r,m"(val) : "memory");
+#endif // _MSC_VER
+}
+
+struct bench_span { // memory evicted for cache-cold runs
+    const void *ptr;
+    uint64_t size;
+};
+
+// flushes `spans` out of all cache levels
+inline void evict_spans(const std::vector<bench_span> &spans) noexcept {
+#if IW_BENCH_CLFLUSH
+    for (const bench_span &span: spans) {
+        const char *ptr = static_cast<const char *>(span.ptr);
+        for (uint64_t off = 0; off < span.size; off += 64) {
+            _mm_clflush(ptr + off);
+        }
+        _mm_clflush(ptr + span.size - 1);
+    }
+    _mm_mfence();
+#else // IW_BENCH_CLFLUSH, sweeps a buffer larger than caches
+    static std::vector<uint64_t> sweep(uint64_t(1) << 23);
+    for (uint64_t &word: sweep) {
+        word += spans.size();
+    }
+    keep_alive(sweep.back());
+#endif // IW_BENCH_CLFLUSH
+}
+
+struct bench_result {
+    char name[64];
+    uint64_t iters;
+    double ns_op, ops_s;
+    double p50, p90, p99; // ns per op, within chunks of `CHUNK`
+};
+
+struct bench_suite {
+
+using str_t = const char *;
+using clk_t = std::chrono::steady_clock;
+
+static constexpr uint64_t CHUNK = 16; // ops per latency sample
+
+double min_ns = 1e7, tolerance = 0.5, noise_ns = 0.5;
+uint64_t repeats = 3; // fastest repetition kept, as noise is one-sided
+str_t json = nullptr, baseline = nullptr, filter = nullptr;
+std::vector<bench_result> results;
+std::vector<bench_span> evicts; // cache-cold runs if not empty
+
+// --json=PATH --baseline=PATH --tolerance=R --min-time=MS
+// --filter=SUBSTR --repetitions=N
+bench_suite(int argc, char **argv) noexcept {
+    constexpr str_t KEYS[] = {
+        "--json=", "--baseline=", "--tolerance=",
+        "--min-time=", "--filter=", "--repetitions=",
+    };
+    for (int i = 1; i < argc; i++) {
+        str_t arg = argv[i], val = nullptr;
+        int k = 0;
+        for (; k < 6; k++) {
+            uint64_t len = std::strlen(KEYS[k]);
+            if (std::strncmp(arg, KEYS[k], len) == 0) {
+                val = arg + len;
+                break;
+            }
+        }
+        switch (k) {
+        case 0: json = val; break;
+        case 1: baseline = val; break;
+        case 2: tolerance = std::atof(val); break;
+        case 3: min_ns = 1e6 * std::atof(val); break;
+        case 4: filter = val; break;
+        case 5: repeats = std::max(std::atoi(val), 1); break;
+        default: std::fprintf(stderr, "Unknown option %s\n", arg);
+        }
+    }
+}
+
+bench_suite(const bench_suite &) = delete;
+
+static double elapsed(clk_t::time_point t0, clk_t::time_point t1) {
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+// `run(beg, end)` performs ops `[beg, end)` of `num`
+template <class Run>
+void measure(str_t name, str_t dist, uint64_t num, Run run) {
+    bench_result res = {};
+    std::snprintf(res.name, sizeof(res.name), "%s/%s", name, dist);
+    if (filter != nullptr && !std::strstr(res.name, filter)) {
+        return;
+    }
+    run(uint64_t(0), num); // warm up
+    // throughput: median of passes, robust to preemption
+    bool cold = !evicts.empty();
+    std::vector<double> pass;
+    double total = 0.0;
+    while (!cold && (total < min_ns || pass.size() < 5)) {
+        auto t0 = clk_t::now();
+        run(uint64_t(0), num);
+        auto t1 = clk_t::now();
+        pass.push_back(elapsed(t0, t1));
+        total += pass.back();
+    }
+    // latency: timed chunks, less the clock overhead
+    std::vector<double> lats, idle(64);
+    for (double &lat: idle) {
+        auto t0 = clk_t::now();
+        auto t1 = clk_t::now();
+        lat = elapsed(t0, t1);
+    }
+    std::nth_element(idle.begin(), idle.begin() + 32, idle.end());
+    double over = idle[32];
+    double spent = 0.0, sum = 0.0;
+    do {
+        for (uint64_t beg = 0; beg + CHUNK <= num; beg += CHUNK) {
+            if (cold) {
+                evict_spans(evicts);
+            }
+            auto t0 = clk_t::now();
+            run(beg, beg + CHUNK);
+            auto t1 = clk_t::now();
+            double dt = elapsed(t0, t1);
+            lats.push_back(std::max(dt - over, 0.0) / CHUNK);
+            spent += dt, sum += lats.back();
+        }
+    } while (spent < (cold ? min_ns : min_ns / 4));
+    if (cold) { // throughput: mean of chunks, each cold
+        res.iters = lats.size() * CHUNK;
+        res.ns_op = sum / double(lats.size());
+    } else {
+        auto mid = pass.begin() + pass.size() / 2;
+        std::nth_element(pass.begin(), mid, pass.end());
+        res.iters = pass.size() * num;
+        res.ns_op = *mid / double(num);
+    }
+    res.ops_s = 1e9 / res.ns_op;
+    std::sort(lats.begin(), lats.end());
+    auto rank = [&lats](double q) {
+        return lats[uint64_t(q * double(lats.size() - 1))];
+    };
+    res.p50 = rank(0.50), res.p90 = rank(0.90), res.p99 = rank(0.99);
+    for (bench_result &old: results) {
+        if (std::strcmp(old.name, res.name) == 0) {
+            res.iters += old.iters;
+            old = (res.ns_op < old.ns_op) ? res : old;
+            old.iters = res.iters;
+            return;
+        }
+    }
+    results.push_back(res);
+}
+
+// one call of `func` per op, args unpacked from `ins`
+template <class Ret, class... Args>
+void bench(str_t name, str_t dist, Ret (*func)(Args...),
+    const std::vector<std::tuple<Args...>> &ins
+) {
+    const std::tuple<Args...> *args = ins.data();
+    this->measure(name, dist, ins.size(),
+        [func, args](uint64_t beg, uint64_t end) {
+            for (uint64_t i = beg; i < end; i++) {
+                keep_alive(std::apply(func, args[i]));
+            }
+        }
+    );
+}
+
+// `func(ins, outs, num)` over arrays, one op per item
+template <class Out, class In, class Func>
+void bulk(str_t name, str_t dist, Func func,
+    const std::vector<In> &ins
+) {
+    std::vector<Out> outs(ins.size());
+    const In *pin = ins.data();
+    Out *pout = outs.data();
+    this->measure(name, dist, ins.size(),
+        [func, pin, pout](uint64_t beg, uint64_t end) {
+            func(pin + beg, pout + beg, end - beg);
+            keep_alive(pout[end - 1]);
+        }
+    );
+}
+
+bool write_json(str_t path) const noexcept {
+    std::FILE *fp = std::fopen(path, "w");
+    if (fp == nullptr) {
+        std::fprintf(stderr, "Cannot write to %s\n", path);
+        return false;
+    }
+    char when[32] = "";
+    std::time_t now = std::time(nullptr);
+#if _MSC_VER
+    std::tm stm, *ptm = &stm;
+    gmtime_s(ptm, &now);
+#else // _MSC_VER
+    std::tm *ptm = std::gmtime(&now);
+#endif // _MSC_VER
+    std::strftime(when, sizeof(when), "%Y-%m-%dT%H:%M:%SZ", ptm);
+    std::fprintf(fp, "{\n  \"context\": {\"date\": \"%s\", "
+        "\"min_time_ms\": %g, \"chunk\": %" PRIu64 "},\n"
+        "  \"benchmarks\": [\n", when, min_ns / 1e6, CHUNK
+    );
+    // one benchmark per line, as `read_json` expects
+    for (uint64_t i = 0; i < results.size(); i++) {
+        const bench_result &res = results[i];
+        std::fprintf(fp, "    {\"name\": \"%s\", "
+            "\"iterations\": %" PRIu64 ", \"ns_per_op\": %.4f, "
+            "\"ops_per_sec\": %.6g, \"p50_ns\": %.4f, "
+            "\"p90_ns\": %.4f, \"p99_ns\": %.4f}%s\n",
+            res.name, res.iters, res.ns_op, res.ops_s,
+            res.p50, res.p90, res.p99,
+            (i + 1 < results.size()) ? "," : ""
+        );
+    }
+    std::fprintf(fp, "  ]\n}\n");
+    std::fclose(fp);
+    return true;
+}
+
+// names and ns/op of benchmarks written by `write_json`
+static std::vector<bench_result> read_json(str_t path) noexcept {
+    std::vector<bench_result> base;
+    std::FILE *fp = std::fopen(path, "r");
+    if (fp == nullptr) {
+        return base;
+    }
+    char line[512];
+    while (std::fgets(line, sizeof(line), fp)) {
+        str_t name = std::strstr(line, "\"name\": \"");
+        str_t nsop = std::strstr(line, "\"ns_per_op\": ");
+        if (name == nullptr || nsop == nullptr) {
+            continue;
+        }
+        bench_result res = {};
+        name += std::strlen("\"name\": \"");
+        uint64_t len = std::strcspn(name, "\"");
+        len = std::min<uint64_t>(len, sizeof(res.name) - 1);
+        std::memcpy(res.name, name, len);
+        res.ns_op = std::atof(nsop + std::strlen("\"ns_per_op\": "));
+        base.push_back(res);
+    }
+    std::fclose(fp);
+    return base;
+}
+
+// count of benchmarks slower than baseline beyond tolerance
+uint64_t compare(const std::vector<bench_result> &base) const noexcept {
+    uint64_t slow = 0;
+    for (const bench_result &res: results) {
+        for (const bench_result &old: base) {
+            if (std::strcmp(res.name, old.name) != 0) {
+                continue;
+            }
+            double limit = old.ns_op * (1.0 + tolerance);
+            limit = std::max(limit, old.ns_op + noise_ns);
+            if (res.ns_op > limit) {
+                std::fprintf(stderr, "[X] %s regressed: %.2f ns "
+                    "over %.2f ns of baseline\n",
+                    res.name, res.ns_op, old.ns_op
+                );
+                slow += 1;
+            }
+            break;
+        }
+    }
+    return slow;
+}
+
+void report() const noexcept {
+    constexpr str_t FMT[] = {
+        "%-40s %9s %12s %8s %8s %8s %10s\n",
+        "%-40s %9.2f %12.4g %8.2f %8.2f %8.2f %10" PRIu64 "\n",
+    };
+    std::printf(FMT[0], "Benchmark", "ns/op", "ops/s",
+        "p50", "p90", "p99", "iters");
+    for (const bench_result &res: results) {
+        std::printf(FMT[1], res.name, res.ns_op, res.ops_s,
+            res.p50, res.p90, res.p99, res.iters
+        );
+    }
+}
+
+int complete() const noexcept {
+    this->report();
+    if (json != nullptr && !this->write_json(json)) {
+        return 1;
+    }
+    if (baseline == nullptr) {
+        return 0;
+    }
+    // nothing to compare against, distinct from regressions
+    std::vector<bench_result> base = read_json(baseline);
+    if (base.empty()) {
+        std::fprintf(stderr, "No baseline read from %s, "
+            "written by `bench_baseline` first\n", baseline);
+        return 2;
+    }
+    uint64_t slow = this->compare(base);
+    if (slow == 0) {
+        std::printf("No regression against %s\n", baseline);
+    } else {
+        std::fprintf(stderr, "%" PRIu64 " regression%s against %s\n",
+            slow, (slow == 1) ? "" : "s", baseline
+        );
+    }
+    return slow != 0;
+}
+
+}; // struct bench_suite
+
+} // namespace iw17
+
+#endif // IW_BENCH_HPP
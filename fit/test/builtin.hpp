@@ -0,0 +1,62 @@
+#ifndef IW_BUILTIN_HPP
+#define IW_BUILTIN_HPP 20251016L
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "../data.hpp"
+#include "../mapped.hpp"
+
+// tables of `data.hpp` in the format of `coefs.py --binary`
+inline std::vector<uint8_t> builtin_bytes() {
+    namespace data = iw17::data;
+    namespace mapped = iw17::mapped;
+    using namespace data::limits;
+    mapped::layout head = {};
+    std::memcpy(head.magic, mapped::MAGIC, sizeof(head.magic));
+    head.version = mapped::VERSION;
+    head.head_bytes = sizeof(mapped::layout);
+    head.nian_min = NIAN_MIN, head.nian_max = NIAN_MAX;
+    head.sui_min = SUI_MIN, head.sui_max = SUI_MAX;
+    head.year_min = YEAR_MIN, head.year_max = YEAR_MAX;
+    head.cyue_min = CYUE_MIN, head.cyue_max = CYUE_MAX;
+    head.cjie_min = CJIE_MIN, head.cjie_max = CJIE_MAX;
+    head.ny_bits = data::NY_BITS, head.yd_bits = data::YD_BITS;
+    head.dy_bits = data::DY_BITS, head.yn_bits = data::YN_BITS;
+    head.js_bits = data::JS_BITS, head.sj_bits = data::SJ_BITS;
+    std::memcpy(head.ny_coef, data::NY_COEF, sizeof(head.ny_coef));
+    std::memcpy(head.yd_coef, data::YD_COEF, sizeof(head.yd_coef));
+    std::memcpy(head.dy_coef, data::DY_COEF, sizeof(head.dy_coef));
+    std::memcpy(head.yn_coef, data::YN_COEF, sizeof(head.yn_coef));
+    std::memcpy(head.js_clin, data::JS_CLIN, sizeof(head.js_clin));
+    std::memcpy(head.js_coef, data::JS_COEF, sizeof(head.js_coef));
+    std::memcpy(head.sj_coef, data::SJ_COEF, sizeof(head.sj_coef));
+    std::vector<uint8_t> body(sizeof(head));
+    auto put = [&body](const void *src, uint64_t len) {
+        body.resize((body.size() + 63) / 64 * 64);
+        const uint8_t *bytes = static_cast<const uint8_t *>(src);
+        body.insert(body.end(), bytes, bytes + len);
+        return mapped::table_ref{body.size() - len, len};
+    };
+    head.nr_runs = put(data::NR_RUNS, sizeof(data::NR_RUNS));
+    head.ny_resy = put(data::NY_RESY, sizeof(data::NY_RESY));
+    // pages joined, as many bytes as read
+    uint64_t cyues = CYUE_MAX + 2 - CYUE_MIN;
+    uint64_t ijie = CJIE_MAX - CJIE_MIN;
+    std::vector<uint8_t> yd((cyues + 3) / 4);
+    std::vector<uint8_t> js(ijie + (ijie >> 1) + 2);
+    for (uint64_t i = 0; i < yd.size(); i++) {
+        yd[i] = data::YD_ARRD[i / data::YD_PAGE][i % data::YD_PAGE];
+    }
+    for (uint64_t i = 0; i < js.size(); i++) {
+        js[i] = data::JS_ARRS[i / data::JS_PAGE][i % data::JS_PAGE];
+    }
+    head.yd_resd = put(yd.data(), yd.size());
+    head.js_ress = put(js.data(), js.size());
+    head.file_bytes = body.size();
+    std::memcpy(body.data(), &head, sizeof(head));
+    return body;
+}
+
+#endif // IW_BUILTIN_HPP
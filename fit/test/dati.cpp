@@ -58,6 +58,20 @@ constexpr bool vldis[N] = {
     true, false, false, true, false, false,
 };
 
+// affine conversions against the reference, on udays [lo, hi]
+bool affine_udays(int32_t lo, int32_t hi) {
+    for (int32_t uday = lo; uday <= hi; uday++) {
+        iw17::date locd = iw17::_ref::uday_to_date(uday);
+        if (!(iw17::uday_to_date(uday) == locd)) {
+            return false;
+        }
+        if (iw17::date_to_uday(locd) != uday) {
+            return false;
+        }
+    }
+    return true;
+}
+
 int main() {
     iw17::test_suite suite;
     for (uint64_t i = 0; i < N; i++) {
@@ -89,5 +103,17 @@ int main() {
             vldis[i], iw17::check_dati, chkis[i]
         );
     }
+    suite.test("days_in_month",
+        int8_t(29), iw17::days_in_month, int16_t(2000), int8_t(2));
+    suite.test("days_in_month",
+        int8_t(28), iw17::days_in_month, int16_t(2100), int8_t(2));
+    suite.test("days_in_month",
+        int8_t(30), iw17::days_in_month, int16_t(2025), int8_t(4));
+    suite.test("affine_udays", true, affine_udays, -1000000, +1000000);
+    // both ends of `int16_t` years, where the reference holds
+    constexpr int32_t UD_MIN = iw17::_ref::date_to_uday({-32768, 3, 1});
+    constexpr int32_t UD_MAX = iw17::_ref::date_to_uday({32767, 12, 31});
+    suite.test("affine_udays", true, affine_udays, UD_MIN, UD_MIN + 999999);
+    suite.test("affine_udays", true, affine_udays, UD_MAX - 999999, UD_MAX);
     return suite.complete();
 }
\ No newline at end of file
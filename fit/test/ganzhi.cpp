@@ -28,6 +28,14 @@ constexpr iw17::bazi bazis[N] = {
     iw17::bazi{gz::jia_chen, gz::bing_yin, gz::ren_xu, gz::ren_zi},
     iw17::bazi{gz::yi_si, gz::wu_yin, gz::jia_chen, gz::ding_mao},
 };
+// over 68 years from J2000, at 116.4 degrees
+constexpr int64_t far_usecs[2] = {
+    -2208436728, +7162463504,
+};
+constexpr iw17::bazi far_bazis[2] = {
+    iw17::bazi{gz::ji_hai, gz::ding_chou, gz::geng_chen, gz::jia_shen},
+    iw17::bazi{gz::bing_shen, gz::geng_zi, gz::geng_shen, gz::wu_yin},
+};
 constexpr iw17::ganzhi nzhus[N] = {
     gz::ji_you, gz::jia_shen, gz::jia_chen, gz::yi_si,
 };
@@ -52,6 +60,92 @@ constexpr int32_t toufus[N] = {
 constexpr int32_t sanfus[N] = {
     +219, +12639, +19949, +20309,
 };
+constexpr iw17::futian futs[N] = {
+    iw17::futian{  +199,   +209,   +219,   +229},
+    iw17::futian{+12619, +12629, +12639, +12649},
+    iw17::futian{+19919, +19929, +19949, +19959},
+    iw17::futian{+20289, +20299, +20309, +20319},
+};
+constexpr iw17::date jiu01s[N] = {
+    iw17::date{1969, 12, 22},
+    iw17::date{2003, 12, 22},
+    iw17::date{2023, 12, 22},
+    iw17::date{2024, 12, 21},
+};
+constexpr iw17::date jiu81s[N] = {
+    iw17::date{1970,  3, 12},
+    iw17::date{2004,  3, 11},
+    iw17::date{2024,  3, 11},
+    iw17::date{2025,  3, 11},
+};
+
+// first and last days of `shujiu`
+iw17::date shujiu_first(int16_t sui) {
+    iw17::shujiu shu = iw17::sui_to_shujiu(sui);
+    return iw17::uday_to_date(shu.jius[0]);
+}
+
+iw17::date shujiu_last(int16_t sui) {
+    iw17::shujiu shu = iw17::sui_to_shujiu(sui);
+    return iw17::uday_to_date(shu.jius[9] - 1);
+}
+
+// `futian`s and `shujiu`s of all `sui`s, in batch against single
+bool batch_sui_to_fujiu() {
+    using iw17::SUI_MIN, iw17::SUI_MAX;
+    constexpr uint64_t NUM_SUI = SUI_MAX + 1 - SUI_MIN;
+    static iw17::futian fts[NUM_SUI];
+    static iw17::shujiu sjs[NUM_SUI];
+    iw17::batch::sui_to_futian(SUI_MIN, fts, NUM_SUI);
+    iw17::batch::sui_to_shujiu(SUI_MIN, sjs, NUM_SUI);
+    for (uint64_t i = 0; i < NUM_SUI; i++) {
+        int16_t sui = SUI_MIN + int16_t(i);
+        iw17::futian fut = fts[i];
+        bool fine = fut.toufu + 10 == fut.erfu
+            && (fut.sanfu - fut.erfu == 10 || fut.sanfu - fut.erfu == 20)
+            && fut.sanfu + 10 == fut.udnx
+            && fut.toufu == iw17::sui_to_toufu(sui)
+            && fut.sanfu == iw17::sui_to_sanfu(sui)
+            && sjs[i] == iw17::sui_to_shujiu(sui)
+            && iw17::usec_to_cjie(int64_t(sjs[i].jius[0]) * 86400)
+                <= iw17::shihou_to_cjie({sui, iw17::jieqi::dongzhi});
+        if (!fine) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// cached `usec_to_bazi` against exact, near each hour of each day
+bool eot_cache_bazi(int32_t step, double lon) {
+    using iw17::_tab::EO_MIN, iw17::_tab::EO_MAX;
+    for (int32_t uday = EO_MIN + 1; uday < EO_MAX; uday += step) {
+        if (!iw17::_tab::check_bazi(uday, lon)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// cached EoT against exact, within 0.13 second
+bool eot_cache_error(int64_t step) {
+    using iw17::CJIE_MIN, iw17::CJIE_MAX;
+    constexpr int64_t TOL = 8520; // 0.13 in 1/65536
+    int64_t usec_min = iw17::cjie_to_usec(CJIE_MIN);
+    int64_t usec_max = iw17::cjie_to_usec(CJIE_MAX);
+    for (int64_t usec = usec_min; usec < usec_max; usec += step) {
+        int32_t cjie = iw17::usec_to_cjie(usec);
+        auto span = iw17::_rst::cjie_to_span(cjie);
+        auto real = iw17::_rst::usec_to_eots(usec, span);
+        auto fast = iw17::_tab::usec_to_eots(usec);
+        int64_t diff = iw17::math::pour_int64(fast - real);
+        diff >>= iw17::math::fix::FBITS - 16;
+        if (diff > TOL || diff < -TOL) {
+            return false;
+        }
+    }
+    return true;
+}
 
 int main() {
     iw17::test_suite suite;
@@ -83,6 +177,15 @@ int main() {
         suite.test("sui_to_sanfu",
             sanfus[i], iw17::sui_to_sanfu, suis[i]
         );
+        suite.test("sui_to_futian",
+            futs[i], iw17::sui_to_futian, suis[i]
+        );
+        suite.test("sui_to_shujiu",
+            jiu01s[i], shujiu_first, suis[i]
+        );
+        suite.test("sui_to_shujiu",
+            jiu81s[i], shujiu_last, suis[i]
+        );
         suite.test("usec_to_bazi",
             bazis[i], iw17::usec_to_bazi, usecs[i], 119.0
         );
@@ -90,5 +193,20 @@ int main() {
             bazis[i], iw17::dati_to_bazi, datis[i], 119.0
         );
     }
+    for (uint64_t i = 0; i < 2; i++) {
+        suite.test("usec_to_bazi",
+            far_bazis[i], iw17::usec_to_bazi, far_usecs[i], 116.4
+        );
+    }
+    suite.test("batch::sui_to_futian", true, batch_sui_to_fujiu);
+    suite.test("_tab::check_bazi",
+        true, eot_cache_bazi, 13, 116.4
+    );
+    suite.test("_tab::check_bazi",
+        true, eot_cache_bazi, 17, -73.9
+    );
+    suite.test("_tab::usec_to_eots",
+        true, eot_cache_error, int64_t(3607)
+    );
     return suite.complete();
 }
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test.hpp"
+#include "../hanzi.hpp"
+
+using gz = iw17::ganzhi;
+using jq = iw17::jieqi;
+using st = iw17::hanzi::status;
+
+constexpr uint64_t N = 4;
+
+constexpr iw17::riqi riqis[N] = {
+    iw17::riqi{1949,  16,  11},
+    iw17::riqi{2020,   9,   1},
+    iw17::riqi{2023,  24,  30},
+    iw17::riqi{2033,  23,  29}, // leap after the 11th
+};
+constexpr const char *riqi_names[N] = {
+    "己丑年八月十一",
+    "庚子年闰四月初一",
+    "癸卯年十二月三十",
+    "癸丑年闰十一月廿九",
+};
+constexpr iw17::shihou shihous[N] = {
+    iw17::shihou{1945, jq::liqiu},
+    iw17::shihou{1970, jq::dongzhi},
+    iw17::shihou{2000, jq::xiazhi},
+    iw17::shihou{2024, jq::daxue},
+};
+constexpr const char *shihou_names[N] = {
+    "一九四五岁立秋",
+    "一九七〇岁冬至",
+    "二〇〇〇岁夏至",
+    "二〇二四岁大雪",
+};
+constexpr iw17::bazi bazis[N] = {
+    iw17::bazi{gz::ji_you, gz::bing_zi, gz::xin_si, gz::ren_chen},
+    iw17::bazi{gz::jia_shen, gz::ding_mao, gz::ji_hai, gz::ren_shen},
+    iw17::bazi{gz::jia_chen, gz::bing_yin, gz::ren_xu, gz::ren_zi},
+    iw17::bazi{gz::yi_si, gz::wu_yin, gz::jia_chen, gz::ding_mao},
+};
+constexpr const char *bazi_names[N] = {
+    "己酉年丙子月辛巳日壬辰时",
+    "甲申年丁卯月己亥日壬申时",
+    "甲辰年丙寅月壬戌日壬子时",
+    "乙巳年戊寅月甲辰日丁卯时",
+};
+
+std::string riqi_name(iw17::riqi rizi) {
+    char buf[iw17::hanzi::RIQI_MAX];
+    return std::string(buf, iw17::hanzi::format_riqi(rizi, buf));
+}
+
+std::string yue_name(int16_t nian, int8_t ryue) {
+    char buf[iw17::hanzi::YUE_MAX];
+    return std::string(buf, iw17::hanzi::format_yue(nian, ryue, buf));
+}
+
+std::string shihou_name(iw17::shihou shi) {
+    char buf[iw17::hanzi::SHIHOU_MAX];
+    return std::string(buf, iw17::hanzi::format_shihou(shi, buf));
+}
+
+std::string bazi_name(iw17::bazi zhus) {
+    char buf[iw17::hanzi::BAZI_MAX];
+    return std::string(buf, iw17::hanzi::format_bazi(zhus, buf));
+}
+
+// a page from 2024-02-03 to 2024-02-11, with `lichun` and `chunjie`
+std::string page() {
+    char buf[9 * iw17::hanzi::batch::LINE_MAX];
+    int32_t uday = iw17::date_to_uday({2024, 2, 3});
+    char *end = iw17::hanzi::batch::format_days(uday, buf, 9);
+    return std::string(buf, end);
+}
+
+// all days in range, in pages of 1000, each line within `LINE_MAX`
+// and matching single ones
+bool all_pages() {
+    constexpr uint64_t PAGE = 1000;
+    static char buf[PAGE * iw17::hanzi::batch::LINE_MAX];
+    int32_t ud01 = iw17::nian_to_range(iw17::NIAN_MIN).first;
+    int32_t udnx = iw17::nian_to_range(iw17::NIAN_MAX).last + 1;
+    for (int32_t uday = ud01; uday < udnx; uday += int32_t(PAGE)) {
+        uint64_t num = std::min<uint64_t>(PAGE, udnx - uday);
+        char *end = iw17::hanzi::batch::format_days(uday, buf, num);
+        const char *line = buf;
+        for (uint64_t i = 0; i < num; i++) {
+            const char *eol = line;
+            while (eol < end && *eol != '\n') {
+                eol++;
+            }
+            uint64_t len = uint64_t(eol - line) + 1;
+            std::string rizi = riqi_name(
+                iw17::uday_to_riqi(uday + int32_t(i)));
+            if (eol == end || len > iw17::hanzi::batch::LINE_MAX
+                || std::string(line + 11, rizi.size()) != rizi) {
+                return false;
+            }
+            line = eol + 1;
+        }
+        if (line != end) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the status, and `riqi{}` if not `ok`
+constexpr std::pair<st, iw17::riqi> parse(const char *text) {
+    iw17::riqi rizi = {};
+    st stat = iw17::hanzi::parse_riqi(text, rizi);
+    return {stat, rizi};
+}
+
+constexpr std::pair<st, gz> parse_gz(const char *text) {
+    gz zhu = gz::jia_zi;
+    st stat = iw17::hanzi::parse_ganzhi(text, zhu);
+    return {stat, zhu};
+}
+
+constexpr std::pair<st, jq> parse_jq(const char *text) {
+    jq jie = jq::dongzhi;
+    st stat = iw17::hanzi::parse_jieqi(text, jie);
+    return {stat, jie};
+}
+
+// `nian` in digits, and the rest of `format_riqi` after the `ganzhi`
+std::string digit_name(iw17::riqi rizi) {
+    char buf[iw17::hanzi::RIQI_MAX];
+    char *end = iw17::hanzi::_hz::put_digits(buf, uint32_t(rizi.nian));
+    return std::string(buf, end) + riqi_name(rizi).substr(6);
+}
+
+// all `riqi`s in range, in a page of lines, back by `batch`
+bool all_lines() {
+    int32_t ud01 = iw17::nian_to_range(iw17::NIAN_MIN).first;
+    int32_t udnx = iw17::nian_to_range(iw17::NIAN_MAX).last + 1;
+    std::string text;
+    for (int32_t uday = ud01; uday < udnx; uday++) {
+        text += digit_name(iw17::uday_to_riqi(uday));
+        text += (uday % 7 == 0) ? "\r\n" : "\n";
+    }
+    uint64_t num = uint64_t(udnx - ud01);
+    std::vector<iw17::riqi> rizis(num + 1);
+    std::vector<st> stats(num + 1);
+    uint64_t got = iw17::hanzi::batch::parse_riqi(text.data(),
+        text.data() + text.size(), rizis.data(), stats.data(), num + 1);
+    if (got != num) {
+        return false;
+    }
+    for (uint64_t i = 0; i < num; i++) {
+        iw17::riqi rizi = iw17::uday_to_riqi(ud01 + int32_t(i));
+        if (stats[i] != st::ok || !(rizis[i] == rizi)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    iw17::test_suite suite;
+    for (uint64_t i = 0; i < N; i++) {
+        suite.test("format_riqi",
+            std::string(riqi_names[i]), riqi_name, riqis[i]
+        );
+        suite.test("format_shihou",
+            std::string(shihou_names[i]), shihou_name, shihous[i]
+        );
+        suite.test("format_bazi",
+            std::string(bazi_names[i]), bazi_name, bazis[i]
+        );
+    }
+    suite.test("format_yue",
+        std::string("闰四月小"), yue_name, int16_t(2020), int8_t(9));
+    suite.test("format_yue",
+        std::string("十二月大"), yue_name, int16_t(2023), int8_t(24));
+    // not valid, none written
+    suite.test("format_riqi",
+        std::string(), riqi_name, iw17::riqi{2020, 11, 1});
+    suite.test("format_riqi",
+        std::string(), riqi_name, iw17::riqi{2200, 2, 1});
+    suite.test("format_yue",
+        std::string(), yue_name, int16_t(2021), int8_t(9));
+    suite.test("format_shihou",
+        std::string(), shihou_name, iw17::shihou{-1, jq::lichun});
+    suite.test("format_bazi", std::string(), bazi_name,
+        iw17::bazi{gz::jia_zi, gz::jia_zi, gz(60), gz::jia_zi});
+    suite.test("batch::format_days", std::string(
+        "2024-02-03 癸卯年十二月廿四 丁酉日\n"
+        "2024-02-04 癸卯年十二月廿五 戊戌日 立春\n"
+        "2024-02-05 癸卯年十二月廿六 己亥日\n"
+        "2024-02-06 癸卯年十二月廿七 庚子日\n"
+        "2024-02-07 癸卯年十二月廿八 辛丑日\n"
+        "2024-02-08 癸卯年十二月廿九 壬寅日\n"
+        "2024-02-09 癸卯年十二月三十 癸卯日\n"
+        "2024-02-10 甲辰年正月初一 甲辰日\n"
+        "2024-02-11 甲辰年正月初二 乙巳日\n"
+    ), page);
+    suite.test("batch::format_days", true, all_pages);
+    suite.test("parse_riqi", std::pair(st::ok, iw17::riqi{1990, 11, 23}),
+        parse, "一九九零年闰五月廿三");
+    suite.test("parse_riqi", std::pair(st::ok, iw17::riqi{2023, 22, 10}),
+        parse, "二〇二三年冬月初十");
+    suite.test("parse_riqi", std::pair(st::ok, iw17::riqi{2033, 23, 29}),
+        parse, "二〇三三年闰十一月廿九");
+    suite.test("parse_riqi", std::pair(st::unknown, iw17::riqi{}),
+        parse, "1990年闰五月廿三");
+    suite.test("parse_riqi", std::pair(st::malformed, iw17::riqi{}),
+        parse, "一九九零年闰五月廿三日");
+    suite.test("parse_riqi", std::pair(st::malformed, iw17::riqi{}),
+        parse, "庚午年闰五月廿三");
+    suite.test("parse_riqi", std::pair(st::malformed, iw17::riqi{}),
+        parse, "一九九零年一月廿三");
+    suite.test("parse_riqi", std::pair(st::malformed, iw17::riqi{}),
+        parse, "一九九零年五月二十三");
+    suite.test("parse_riqi", std::pair(st::invalid, iw17::riqi{}),
+        parse, "二〇二〇年闰四月三十"); // of 29 days
+    suite.test("parse_riqi", std::pair(st::invalid, iw17::riqi{}),
+        parse, "二〇二一年闰四月初一");
+    suite.test("parse_riqi", std::pair(st::invalid, iw17::riqi{}),
+        parse, "一八九九年正月初一");
+    suite.test("parse_ganzhi", std::pair(st::ok, gz::geng_wu),
+        parse_gz, "庚午年");
+    suite.test("parse_ganzhi", std::pair(st::ok, gz::gui_hai),
+        parse_gz, "癸亥");
+    suite.test("parse_ganzhi", std::pair(st::invalid, gz::jia_zi),
+        parse_gz, "甲丑");
+    suite.test("parse_ganzhi", std::pair(st::malformed, gz::jia_zi),
+        parse_gz, "午庚年");
+    suite.test("parse_jieqi", std::pair(st::ok, jq::jingzhe),
+        parse_jq, "惊蛰");
+    suite.test("parse_jieqi", std::pair(st::unknown, jq::dongzhi),
+        parse_jq, "春立");
+    suite.test("parse_jieqi", std::pair(st::malformed, jq::dongzhi),
+        parse_jq, "立春节");
+    suite.test("batch::parse_riqi", true, all_lines);
+    static_assert(parse("二〇二四年正月初一").second.nian == 2024);
+    static_assert(parse_jq("大雪").second == jq::daxue);
+    static_assert(iw17::hanzi::name(gz::gui_hai) == "癸亥");
+    static_assert(iw17::hanzi::name(iw17::zodiac::pisces) == "双鱼座");
+    return suite.complete();
+}
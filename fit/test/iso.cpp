@@ -0,0 +1,152 @@
+#include <cstring>
+#include <string>
+
+#include "test.hpp"
+#include "../iso.hpp"
+
+using tz = iw17::tzinfo;
+
+constexpr uint64_t N = 6;
+
+constexpr const char *isos[N] = {
+    "1931-09-18T22:20:00+08:00",
+    "1976-07-28T03:42:53+08:00",
+    "2001-09-11T08:46:40-04:00",
+    "2015-06-30T23:59:59-09:30",
+    "2022-03-21 14:23:00+05:45",
+    "2099-12-31T00:00:00-00:00",
+};
+constexpr iw17::dati datis[N] = {
+    iw17::dati{1931,  9, 18, 22, 20,  0, tz::east_0800},
+    iw17::dati{1976,  7, 28,  3, 42, 53, tz::east_0800},
+    iw17::dati{2001,  9, 11,  8, 46, 40, tz::west_0400},
+    iw17::dati{2015,  6, 30, 23, 59, 59, tz::west_0930},
+    iw17::dati{2022,  3, 21, 14, 23,  0, tz::east_0545},
+    iw17::dati{2099, 12, 31,  0,  0,  0, tz::utc},
+};
+constexpr const char *fmts[N] = {
+    "1931-09-18T22:20:00+08:00",
+    "1976-07-28T03:42:53+08:00",
+    "2001-09-11T08:46:40-04:00",
+    "2015-06-30T23:59:59-09:30",
+    "2022-03-21T14:23:00+05:45",
+    "2099-12-31T00:00:00+00:00",
+};
+constexpr const char *bads[N] = {
+    "2001-02-29T00:00:00+08:00", // not a leap year
+    "2024-13-01T00:00:00+08:00",
+    "2024-01-01T24:00:00+08:00",
+    "2024-01-01T00:00:00+05:20", // not in 15 minutes
+    "2024-01-01T00:00:00+14:15",
+    "2024/01/01T00:00:00+08:00",
+};
+
+constexpr iw17::dati parse(const char *str) {
+    iw17::dati zond = {};
+    return iw17::parse_dati(str, zond) ? zond : iw17::dati{};
+}
+
+std::string format(iw17::dati zond) {
+    char buf[iw17::ISO_LEN] = {};
+    return std::string(buf, iw17::format_dati(zond, buf));
+}
+
+// every 765433 seconds over years 0001 to 9998, zones in turn by `step`
+bool round_trip(int8_t step) {
+    char buf[iw17::ISO_LEN];
+    int64_t usec_min = iw17::uday_to_usec(
+        iw17::date_to_uday({1, 1, 2}));
+    int64_t usec_max = iw17::uday_to_usec(
+        iw17::date_to_uday({9998, 12, 31}));
+    int8_t nzone = int8_t(tz::east_1400) + 1;
+    int8_t ord = 0;
+    for (int64_t usec = usec_min; usec < usec_max; usec += 765433) {
+        ord = (ord + step) % nzone;
+        iw17::dati zond = iw17::usec_to_dati(usec, tz(ord));
+        iw17::dati back = {};
+        if (iw17::format_dati(zond, buf) != buf + iw17::ISO_LEN
+            || !iw17::parse_dati(buf, back) || !(back == zond)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// single bytes of a valid one replaced by all those not allowed
+bool every_byte() {
+    const char *good = isos[0];
+    char buf[iw17::ISO_LEN];
+    for (uint64_t i = 0; i < iw17::ISO_LEN; i++) {
+        bool at_digit = good[i] >= '0' && good[i] <= '9';
+        for (int byte = 0; byte < 256; byte++) {
+            std::memcpy(buf, good, iw17::ISO_LEN);
+            buf[i] = char(byte);
+            bool digit = byte >= '0' && byte <= '9';
+            bool allowed = at_digit ? digit : (buf[i] == good[i]
+                || (i == 10 && byte == ' ') || (i == 19 && byte == '-'));
+            iw17::dati zond = {};
+            if (!allowed && iw17::parse_dati(buf, zond)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// mixed lines, in and out of `batch`
+bool batch_lines() {
+    const std::string text = std::string(isos[0]) + "\n"
+        + isos[1] + "\r\n" + "\n" + bads[0] + "\n" + "short\n"
+        + isos[4] + "\n" + isos[2];
+    iw17::dati zonds[8] = {};
+    uint64_t num = iw17::batch::parse_dati(
+        text.data(), text.data() + text.size(), zonds, 8);
+    const iw17::dati reals[] = {
+        datis[0], datis[1], {}, {}, {}, datis[4], datis[2],
+    };
+    if (num != 7 || iw17::batch::parse_dati(
+        text.data(), text.data() + text.size(), zonds + 7, 0) != 0) {
+        return false;
+    }
+    for (uint64_t i = 0; i < num; i++) {
+        if (!(zonds[i] == reals[i])) {
+            return false;
+        }
+    }
+    char buf[8 * (iw17::ISO_LEN + 1)];
+    char *end = iw17::batch::format_dati(zonds, buf, num);
+    const std::string outs = std::string(fmts[0]) + "\n"
+        + fmts[1] + "\n\n\n\n" + fmts[4] + "\n" + fmts[2] + "\n";
+    return std::string(buf, end) == outs;
+}
+
+int main() {
+    iw17::test_suite suite;
+    for (uint64_t i = 0; i < N; i++) {
+        suite.test("parse_dati", datis[i], parse, isos[i]);
+        suite.test("format_dati",
+            std::string(fmts[i]), format, datis[i]
+        );
+        suite.test("parse_dati", iw17::dati{}, parse, bads[i]);
+    }
+    // minutes of zones out of 0 to 59, not folded into hours
+    for (const char *bad: {
+        "2024-01-01T00:00:00+13:60",
+        "2024-01-01T00:00:00+00:75",
+        "2024-01-01T00:00:00+05:90",
+    }) {
+        suite.test("parse_dati", iw17::dati{}, parse, bad);
+    }
+    // out of 0000 to 9999, or not valid
+    suite.test("format_dati", std::string(), format,
+        iw17::dati{-1, 12, 31, 0, 0, 0, tz::utc});
+    suite.test("format_dati", std::string(), format,
+        iw17::dati{2024, 2, 30, 0, 0, 0, tz::utc});
+    constexpr iw17::dati LEAP = parse("2024-02-29T12:34:56+14:00");
+    static_assert(LEAP.day == 29 && LEAP.zone == tz::east_1400);
+    suite.test("round_trip", true, round_trip, int8_t(1));
+    suite.test("round_trip", true, round_trip, int8_t(13));
+    suite.test("every_byte", true, every_byte);
+    suite.test("batch_lines", true, batch_lines);
+    return suite.complete();
+}
@@ -83,6 +83,273 @@ constexpr bool vldrs[N] = {
     false, true, false, false, false, false,
 };
 
+// birthdays as in README
+constexpr uint64_t K = 6;
+
+constexpr iw17::riqi bdays[K] = {
+    iw17::riqi{1987,  2,  1},
+    iw17::riqi{2004,  4, 30},
+    iw17::riqi{2004,  4, 30},
+    iw17::riqi{2004,  5, 16},
+    iw17::riqi{2004,  5, 16},
+    iw17::riqi{2004,  5, 16},
+};
+constexpr int16_t srnis[K] = {
+    2025, 2023, 2025, 2022, 2023, 2004,
+};
+constexpr iw17::riqi srs[K] = {
+    iw17::riqi{2025,  2,  1},
+    iw17::riqi{2023,  4, 30},
+    iw17::riqi{2025,  4, 29},
+    iw17::riqi{2022,  4, 16},
+    iw17::riqi{2023,  5, 16},
+    iw17::riqi{2004,  5, 16},
+};
+
+// batch conversions against one-by-one ones
+bool batch_uday_to_riqi(int32_t uday, int32_t step) {
+    constexpr uint64_t M = 1000;
+    int32_t uds[M] = {};
+    iw17::riqi rzs[M] = {};
+    for (uint64_t j = 0; j < M; j++) {
+        uds[j] = uday + step * int32_t(j);
+    }
+    iw17::batch::uday_to_riqi(uds, rzs, M);
+    for (uint64_t j = 0; j < M; j++) {
+        iw17::riqi real = iw17::uday_to_riqi(uds[j]);
+        if (!(rzs[j] == real)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool batch_riqi_to_uday(int32_t uday, int32_t step) {
+    constexpr uint64_t M = 1000;
+    iw17::riqi rzs[M] = {};
+    int32_t uds[M] = {};
+    for (uint64_t j = 0; j < M; j++) {
+        rzs[j] = iw17::uday_to_riqi(uday + step * int32_t(j));
+    }
+    iw17::batch::riqi_to_uday(rzs, uds, M);
+    for (uint64_t j = 0; j < M; j++) {
+        if (uds[j] != uday + step * int32_t(j)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// dense tables against fittings, over all valid inputs
+bool dense_nian_to_cyue() {
+    using iw17::NIAN_MIN, iw17::NIAN_MAX;
+    for (int16_t nian = NIAN_MIN; nian <= NIAN_MAX + 1; nian++) {
+        int32_t real = iw17::_fit::nian_to_cyue(nian);
+        if (iw17::_tab::nian_to_cyue(nian) != real) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool dense_cyue_to_uday() {
+    using iw17::CYUE_MIN, iw17::CYUE_MAX;
+    for (int32_t cyue = CYUE_MIN; cyue <= CYUE_MAX + 1; cyue++) {
+        int32_t real = iw17::_fit::cyue_to_uday(cyue);
+        if (iw17::_tab::cyue_to_uday(cyue) != real) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// `cyue`s filled from every start, `num` each, against single ones
+bool range_cyue_to_uday(int32_t num) {
+    using iw17::CYUE_MIN, iw17::CYUE_MAX;
+    int32_t uds[64] = {};
+    for (int32_t cyue = CYUE_MIN; cyue <= CYUE_MAX + 1; cyue++) {
+        int32_t rest = CYUE_MAX + 2 - cyue;
+        int32_t cnt = (num < rest) ? num : rest;
+        iw17::batch::cyue_to_uday(cyue, uds, cnt);
+        for (int32_t j = 0; j < cnt; j++) {
+            if (uds[j] != iw17::cyue_to_uday(cyue + j)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// `yue`s starting in windows of `span` days, against a walk
+bool range_yues_between(int32_t span) {
+    using iw17::CYUE_MIN, iw17::CYUE_MAX;
+    int32_t ud_min = iw17::cyue_to_uday(CYUE_MIN);
+    int32_t ud_end = iw17::cyue_to_uday(CYUE_MAX + 1);
+    int32_t uds[64] = {};
+    for (int32_t from = ud_min - 2 * span; from < ud_end + span;
+        from += 13) {
+        int32_t to = from + span;
+        uint64_t cnt = iw17::batch::yues_between(from, to, uds, 64);
+        uint64_t real = 0;
+        int32_t cyue = CYUE_MIN;
+        for (; cyue <= CYUE_MAX + 1; cyue++) {
+            int32_t ud01 = iw17::cyue_to_uday(cyue);
+            if (ud01 >= to) {
+                break;
+            }
+            if (ud01 < from) {
+                continue;
+            }
+            if (real < 64 && uds[real] != ud01) {
+                return false;
+            }
+            real += 1;
+        }
+        if (cnt != real) {
+            return false;
+        }
+    }
+    return iw17::batch::yues_between(ud_min, ud_min, uds, 64) == 0;
+}
+
+// `nian` summaries against fittings, over all `yue`s
+bool packed_riqi() {
+    using iw17::NIAN_MIN, iw17::NIAN_MAX;
+    namespace _fit = iw17::_fit;
+    namespace _tab = iw17::_tab;
+    for (int16_t nian = NIAN_MIN; nian <= NIAN_MAX; nian++) {
+        int8_t run = iw17::nian_to_run(nian);
+        int32_t cy01 = _fit::nian_to_cyue(nian);
+        int32_t cynx = _fit::nian_to_cyue(nian + 1);
+        for (int32_t cyue = cy01; cyue < cynx; cyue++) {
+            int8_t ryue = iw17::nyue_to_ryue(cyue - cy01, run);
+            int32_t ud01 = _fit::cyue_to_uday(cyue);
+            int8_t hui = _fit::cyue_to_uday(cyue + 1) - ud01;
+            iw17::riqi rizi = {nian, ryue, hui};
+            bool fine = _tab::riqi_to_hui(rizi) == rizi
+                && _tab::riqi_to_uday(rizi) == ud01 + hui - 1
+                && _tab::check_riqi(rizi)
+                && !_tab::check_riqi(iw17::riqi{nian, ryue, 0})
+                && !_tab::check_riqi(iw17::riqi{nian, ryue, 31})
+                && (hui == 30 || !_tab::check_riqi(
+                    iw17::riqi{nian, ryue, 30}
+                ))
+                && (ryue & 1 || ryue >> 1 == run || !_tab::check_riqi(
+                    iw17::riqi{nian, int8_t(ryue + 1), 1}
+                ));
+            if (!fine) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// steps on summaries against the default ones
+bool packed_next(int32_t step) {
+    using iw17::NIAN_MIN, iw17::NIAN_MAX;
+    int16_t nstp = int16_t(step / 13), span = int16_t(step / 12);
+    int16_t nlo = NIAN_MIN + (step < 0 ? -span + 1 : 0);
+    int16_t nhi = NIAN_MAX - (step > 0 ? span + 1 : 0);
+    for (int16_t nian = nlo; nian <= nhi; nian++) {
+        for (int8_t ryue = 2; ryue <= 25; ryue++) {
+            for (int8_t tian: {1, 29, 30}) {
+                iw17::riqi rizi = {nian, ryue, tian};
+                if (!iw17::check_riqi(rizi)) {
+                    continue;
+                }
+                iw17::riqi nian_real = iw17::next_nian(rizi, nstp);
+                iw17::riqi cyue_real = iw17::next_cyue(rizi, step);
+                if (!(iw17::_tab::next_nian(rizi, nstp) == nian_real)
+                    || !(iw17::_tab::next_cyue(rizi, step) == cyue_real)
+                ) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// births on 1st, 29th and 30th of all `yue`s, as summarized
+std::vector<iw17::riqi> yue_births() {
+    using iw17::CYUE_MIN, iw17::CYUE_MAX;
+    std::vector<iw17::riqi> births;
+    for (int32_t cyue = CYUE_MIN; cyue <= CYUE_MAX; cyue++) {
+        int32_t ud01 = iw17::cyue_to_uday(cyue);
+        int32_t udnx = iw17::cyue_to_uday(cyue + 1);
+        for (int32_t uday: {ud01, ud01 + 28, udnx - 1}) {
+            births.push_back(iw17::uday_to_riqi(uday));
+        }
+    }
+    return births;
+}
+
+// batch birthdays against single ones, over all `nian`s
+bool batch_shengri(std::vector<iw17::riqi> births) {
+    using iw17::NIAN_MIN, iw17::NIAN_MAX;
+    constexpr int16_t span = NIAN_MAX + 1 - NIAN_MIN;
+    std::vector<iw17::date> outs(span), rows(span * births.size());
+    iw17::batch::shengri(births.data(), rows.data(), births.size(),
+        NIAN_MIN, span);
+    for (uint64_t i = 0; i < births.size(); i++) {
+        iw17::batch::shengri(births[i], NIAN_MIN, outs.data(), span);
+        for (int16_t k = 0; k < span; k++) {
+            iw17::riqi rizi = iw17::shengri(births[i], NIAN_MIN + k);
+            iw17::date real = iw17::riqi_to_date(rizi);
+            if (!(outs[k] == real) || !(rows[i * span + k] == real)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// a window wider than the range and past both ends, `date{}` outside
+bool batch_shengri_edge(std::vector<iw17::riqi> births) {
+    using iw17::NIAN_MIN, iw17::NIAN_MAX;
+    constexpr int16_t nian = NIAN_MIN - 7;
+    constexpr int16_t span = NIAN_MAX + 20 - nian;
+    std::vector<iw17::date> outs(span), rows(span * births.size());
+    iw17::batch::shengri(births.data(), rows.data(), births.size(),
+        nian, span);
+    for (uint64_t i = 0; i < births.size(); i++) {
+        iw17::batch::shengri(births[i], nian, outs.data(), span);
+        for (int16_t k = 0; k < span; k++) {
+            int16_t ni = nian + k;
+            iw17::date real = (ni < NIAN_MIN || ni > NIAN_MAX)
+                ? iw17::date{}
+                : iw17::riqi_to_date(iw17::shengri(births[i], ni));
+            if (!(outs[k] == real) || !(rows[i * span + k] == real)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// `func` against `yue`s walked one by one, over all `nian`s
+bool walk_uday_to_riqi(iw17::riqi (*func)(int32_t) noexcept) {
+    using iw17::NIAN_MIN, iw17::NIAN_MAX;
+    for (int16_t nian = NIAN_MIN; nian <= NIAN_MAX; nian++) {
+        int8_t run = iw17::nian_to_run(nian);
+        int32_t cy01 = iw17::nian_to_cyue(nian);
+        int32_t cynx = iw17::nian_to_cyue(nian + 1);
+        for (int32_t cyue = cy01; cyue < cynx; cyue++) {
+            int8_t ryue = iw17::nyue_to_ryue(cyue - cy01, run);
+            int32_t ud01 = iw17::cyue_to_uday(cyue);
+            int32_t udnx = iw17::cyue_to_uday(cyue + 1);
+            for (int32_t uday = ud01; uday < udnx; uday++) {
+                int8_t tian = uday - ud01 + 1;
+                if (!(func(uday) == iw17::riqi{nian, ryue, tian})) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
 int main() {
     using namespace iw17::prestd::literal;
     iw17::test_suite suite;
@@ -138,6 +405,50 @@ int main() {
         suite.test("next_tian",
             nt83s[i], iw17::next_tian, rizis[i], 83_i32
         );
+        suite.test("batch::uday_to_riqi",
+            true, batch_uday_to_riqi, udays[i], 1_i32
+        );
+        suite.test("batch::uday_to_riqi",
+            true, batch_uday_to_riqi, udays[i], -3_i32
+        );
+        suite.test("batch::riqi_to_uday",
+            true, batch_riqi_to_uday, udays[i], 1_i32
+        );
+        suite.test("batch::riqi_to_uday",
+            true, batch_riqi_to_uday, udays[i], 37_i32
+        );
+    }
+    suite.test("_tab::nian_to_cyue", true, dense_nian_to_cyue);
+    suite.test("_tab::cyue_to_uday", true, dense_cyue_to_uday);
+    suite.test("batch::cyue_to_uday", true, range_cyue_to_uday, 1_i32);
+    suite.test("batch::cyue_to_uday", true, range_cyue_to_uday, 37_i32);
+    suite.test("batch::yues_between", true, range_yues_between, 30_i32);
+    suite.test("batch::yues_between", true, range_yues_between, 800_i32);
+    for (uint64_t i = 0; i < K; i++) {
+        suite.test("shengri",
+            srs[i], iw17::shengri, bdays[i], srnis[i]
+        );
+    }
+    // out of range, the same on all backends
+    constexpr int16_t outns[] = {
+        -32768, iw17::NIAN_MIN - 1, iw17::NIAN_MAX + 1, 32767,
+    };
+    for (int16_t nian: outns) {
+        suite.test("check_riqi",
+            false, iw17::check_riqi, iw17::riqi{nian, 2, 1}
+        );
     }
+    suite.test("batch::shengri", true, batch_shengri, yue_births());
+    suite.test("batch::shengri", true, batch_shengri_edge, yue_births());
+    suite.test("_tab::nian_info", true, packed_riqi);
+    suite.test("_tab::next_*", true, packed_next, 1_i32);
+    suite.test("_tab::next_*", true, packed_next, -40_i32);
+    suite.test("_tab::next_*", true, packed_next, 250_i32);
+    suite.test("uday_to_riqi",
+        true, walk_uday_to_riqi, iw17::uday_to_riqi
+    );
+    suite.test("_tab::uday_to_riqi",
+        true, walk_uday_to_riqi, iw17::_tab::uday_to_riqi
+    );
     return suite.complete();
 }
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "../mapped.hpp"
+#include "builtin.hpp"
+#include "test.hpp"
+
+namespace data = iw17::data;
+namespace mapped = iw17::mapped;
+
+// the same tables cut into eras of `era` nians, in version 2; each
+// segment refits the linear part of JS and re-anchors the constants
+// of NY and YD at its least residual, so no two segments agree
+std::vector<uint8_t> era_bytes(int16_t era) {
+    using namespace iw17::data::limits;
+    namespace _fit = iw17::_fit;
+    std::vector<uint8_t> full = builtin_bytes();
+    mapped::layout base;
+    std::memcpy(&base, full.data(), sizeof(base));
+    uint32_t nseg = (NIAN_MAX - NIAN_MIN + era) / era;
+    std::vector<mapped::segment> segs(nseg + 1);
+    std::vector<uint8_t> body(sizeof(mapped::directory)
+        + sizeof(mapped::segment) * (nseg + 1));
+    auto put = [&body](std::vector<uint8_t> tab) {
+        body.resize((body.size() + 63) / 64 * 64);
+        body.insert(body.end(), tab.begin(), tab.end());
+        return mapped::table_ref{body.size() - tab.size(), tab.size()};
+    };
+    // `count` items of `bits` each, from `item(0)` on
+    auto pack = [](uint64_t count, int bits, auto item) {
+        std::vector<uint8_t> tab((count * bits + 7) / 8 + 2);
+        for (uint64_t i = 0; i < count; i++) {
+            uint64_t ibit = i * bits, val = item(i);
+            for (int b = 0; b < bits; b++, ibit++) {
+                tab[ibit / 8] |= ((val >> b) & 1) << (ibit % 8);
+            }
+        }
+        return tab;
+    };
+    // least of `count` residuals from `item(0)` on, folded into `coef`
+    auto anchor = [](int64_t &coef, uint64_t count, auto item) {
+        int64_t rmin = item(0);
+        for (uint64_t i = 1; i < count; i++) {
+            rmin = std::min<int64_t>(rmin, item(i));
+        }
+        coef += rmin;
+        return rmin;
+    };
+    std::vector<mapped::layout> heads(nseg, base);
+    for (uint32_t iseg = 0; iseg < nseg; iseg++) {
+        mapped::layout &head = heads[iseg];
+        int16_t lo = NIAN_MIN + era * iseg;
+        int16_t hi = std::min<int16_t>(lo + era - 1, NIAN_MAX);
+        head.nian_min = head.sui_min = head.year_min = lo;
+        head.nian_max = head.sui_max = head.year_max = hi;
+        head.cyue_min = iw17::nian_to_cyue(lo);
+        head.cyue_max = iw17::nian_to_cyue(hi + 1) - 1;
+        head.cjie_min = 24 * (lo - 1970);
+        head.cjie_max = 24 * (hi - 1970) + 23;
+        body.resize((body.size() + 63) / 64 * 64);
+        segs[iseg] = {lo, head.cyue_min, head.cjie_min,
+            iw17::cyue_to_uday(head.cyue_min),
+            iw17::cjie_to_usec(head.cjie_min), body.size()};
+        body.resize(body.size() + sizeof(head));
+        head.nr_runs = put(pack(hi + 2 - lo, 4, [lo](uint64_t i) {
+            return iw17::nian_to_run(std::min<int>(lo + i, NIAN_MAX));
+        }));
+        auto resy = [lo](uint64_t i) { return _fit::ny_resy(lo + i); };
+        int64_t ny = anchor(head.ny_coef[1], hi + 2 - lo, resy);
+        head.ny_resy = put(pack(hi + 2 - lo, 1,
+            [&](uint64_t i) { return resy(i) - ny; }));
+        int32_t ym = head.cyue_min, yn = head.cyue_max + 2 - ym;
+        auto resd = [ym](uint64_t i) { return _fit::yd_resd(ym + i); };
+        int64_t yd = anchor(head.yd_coef[1], yn, resd);
+        head.yd_resd = put(pack(yn, 2,
+            [&](uint64_t i) { return resd(i) - yd; }));
+        // `usec` less the polynomial, fitted on `sui` by least squares
+        int32_t jm = head.cjie_min, jn = head.cjie_max + 1 - jm;
+        std::vector<int64_t> suis(jn), rest(jn);
+        double ms = 0, mr = 0, cov = 0, var = 0;
+        for (int32_t i = 0; i < jn; i++) {
+            iw17::shihou shi = iw17::cjie_to_shihou(jm + i);
+            suis[i] = shi.sui;
+            rest[i] = iw17::cjie_to_usec(jm + i) - _fit::js_pred(shi)
+                + base.js_clin[0] * suis[i] + base.js_clin[1];
+            ms += suis[i], mr += rest[i];
+        }
+        ms /= jn, mr /= jn;
+        for (int32_t i = 0; i < jn; i++) {
+            cov += (suis[i] - ms) * (rest[i] - mr);
+            var += (suis[i] - ms) * (suis[i] - ms);
+        }
+        head.js_clin[0] = std::llround(cov / var);
+        head.js_clin[1] = 0;
+        auto ress = [&](uint64_t i) {
+            return rest[i] - head.js_clin[0] * suis[i] - head.js_clin[1];
+        };
+        anchor(head.js_clin[1], jn, ress);
+        head.js_ress = put(pack(jn, 12, ress));
+    }
+    // ends for interpolation only, the last `usec` estimated
+    segs[nseg] = {NIAN_MAX + 1, CYUE_MAX + 1, CJIE_MAX + 1,
+        iw17::cyue_to_uday(CYUE_MAX + 1),
+        iw17::cjie_to_usec(CJIE_MAX) + 1314873, 0};
+    mapped::directory dir = {};
+    std::memcpy(dir.magic, mapped::MAGIC, sizeof(dir.magic));
+    dir.version = mapped::VERSION_ERAS;
+    dir.head_bytes = sizeof(dir);
+    dir.file_bytes = body.size();
+    dir.segments = nseg;
+    std::memcpy(body.data(), &dir, sizeof(dir));
+    std::memcpy(body.data() + sizeof(dir), segs.data(),
+        sizeof(mapped::segment) * segs.size());
+    for (uint32_t iseg = 0; iseg < nseg; iseg++) {
+        heads[iseg].file_bytes = body.size();
+        std::memcpy(body.data() + segs[iseg].offset, &heads[iseg],
+            sizeof(mapped::layout));
+    }
+    return body;
+}
+
+bool save_bytes(const char *path, std::vector<uint8_t> bytes) {
+    std::FILE *fp = std::fopen(path, "wb");
+    if (fp == nullptr) {
+        return false;
+    }
+    uint64_t put = std::fwrite(bytes.data(), 1, bytes.size(), fp);
+    return (std::fclose(fp) == 0) && put == bytes.size();
+}
+
+// mapped file against compiled tables, over all valid inputs
+bool mapped_lunar(const char *path) {
+    using iw17::NIAN_MIN, iw17::NIAN_MAX;
+    using iw17::CYUE_MIN, iw17::CYUE_MAX;
+    mapped::dataset ds(path);
+    if (!ds.valid()) {
+        return false;
+    }
+    for (int16_t nian = NIAN_MIN; nian <= NIAN_MAX + 1; nian++) {
+        if (ds.nian_to_cyue(nian) != iw17::nian_to_cyue(nian)) {
+            return false;
+        }
+        if (nian <= NIAN_MAX
+            && ds.nian_to_run(nian) != iw17::nian_to_run(nian)) {
+            return false;
+        }
+    }
+    for (int32_t cyue = CYUE_MIN; cyue <= CYUE_MAX + 1; cyue++) {
+        if (ds.cyue_to_uday(cyue) != iw17::cyue_to_uday(cyue)) {
+            return false;
+        }
+    }
+    int32_t uday_min = ds.cyue_to_uday(ds.nian_to_cyue(NIAN_MIN));
+    int32_t uday_max = ds.cyue_to_uday(ds.nian_to_cyue(NIAN_MAX + 1));
+    for (int32_t uday = uday_min; uday < uday_max; uday++) {
+        iw17::riqi rizi = ds.uday_to_riqi(uday);
+        if (!(rizi == iw17::uday_to_riqi(uday))) {
+            return false;
+        }
+        if (ds.riqi_to_uday(rizi) != uday) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool mapped_solar(const char *path) {
+    using iw17::CJIE_MIN, iw17::CJIE_MAX;
+    mapped::dataset ds(path);
+    if (!ds.valid()) {
+        return false;
+    }
+    for (int32_t cjie = CJIE_MIN; cjie <= CJIE_MAX; cjie++) {
+        int64_t usec = iw17::cjie_to_usec(cjie);
+        if (ds.cjie_to_usec(cjie) != usec) {
+            return false;
+        }
+        if (cjie == CJIE_MIN) {
+            continue;
+        }
+        for (int64_t inst: {usec - 1, usec, usec + 3600}) {
+            if (ds.usec_to_cjie(inst) != iw17::usec_to_cjie(inst)) {
+                return false;
+            }
+            auto real = iw17::usec_to_bazi(inst, 116.4);
+            if (!(ds.usec_to_bazi(inst, 116.4) == real)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// damaged copies of `bytes`, all rejected by `attach` and `open`
+bool mapped_reject(const char *path, std::vector<uint8_t> bytes) {
+    mapped::dataset ds;
+    if (!ds.attach(bytes.data(), bytes.size())) {
+        return false;
+    }
+    auto *head = reinterpret_cast<mapped::layout *>(bytes.data());
+    const auto damages = {
+        +[](mapped::layout &h) { h.magic[0] = 'X'; },
+        +[](mapped::layout &h) { h.version = 2; },
+        +[](mapped::layout &h) { h.file_bytes -= 1; },
+        +[](mapped::layout &h) { h.nian_max += 1000; },
+        +[](mapped::layout &h) { h.js_ress.offset += 1; },
+        +[](mapped::layout &h) { h.yd_resd.bytes = 1 << 30; },
+    };
+    for (auto damage: damages) {
+        mapped::layout save = *head;
+        damage(*head);
+        if (ds.attach(bytes.data(), bytes.size())) {
+            return false;
+        }
+        *head = save;
+    }
+    if (ds.attach(bytes.data(), bytes.size() - 64)) {
+        return false; // truncated
+    }
+    bytes[0] = 'X';
+    return save_bytes(path, bytes) && !ds.open(path)
+        && !ds.open("no/such/file.bin") && !ds.valid();
+}
+
+// damaged directories of `bytes`, in version 2
+bool eras_reject(std::vector<uint8_t> bytes) {
+    mapped::dataset ds;
+    if (!ds.attach(bytes.data(), bytes.size()) || ds.segments() != 5) {
+        return false;
+    }
+    auto *dir = reinterpret_cast<mapped::directory *>(bytes.data());
+    auto *segs = reinterpret_cast<mapped::segment *>(dir + 1);
+    const auto damages = {
+        +[](mapped::directory &d, mapped::segment *) { d.version = 3; },
+        +[](mapped::directory &d, mapped::segment *) {
+            d.segments = 1 << 28;
+        },
+        +[](mapped::directory &, mapped::segment *s) {
+            s[2].nian_min -= 1;
+        },
+        +[](mapped::directory &, mapped::segment *s) {
+            s[3].uday_min = s[2].uday_min;
+        },
+        +[](mapped::directory &, mapped::segment *s) {
+            s[1].offset += 64;
+        },
+    };
+    std::vector<uint8_t> save = bytes;
+    for (auto damage: damages) {
+        damage(*dir, segs);
+        if (ds.attach(bytes.data(), bytes.size())) {
+            return false;
+        }
+        bytes = save;
+    }
+    // truncated after the directory and fewer than 2 entries
+    for (uint64_t size: {32, 40, 64}) {
+        std::vector<uint8_t> cut(bytes.begin(), bytes.begin() + size);
+        auto *head = reinterpret_cast<mapped::directory *>(cut.data());
+        head->file_bytes = size, head->segments = 1;
+        if (ds.attach(cut.data(), cut.size())) {
+            return false;
+        }
+    }
+    return ds.attach(bytes.data(), bytes.size());
+}
+
+// coefficients of all segments in `bytes`, not the same in any two
+bool eras_refit(std::vector<uint8_t> bytes) {
+    auto *dir = reinterpret_cast<mapped::directory *>(bytes.data());
+    auto *segs = reinterpret_cast<mapped::segment *>(dir + 1);
+    std::vector<std::vector<int64_t>> coefs;
+    for (uint32_t iseg = 0; iseg < dir->segments; iseg++) {
+        mapped::layout head;
+        std::memcpy(&head, bytes.data() + segs[iseg].offset,
+            sizeof(head));
+        coefs.push_back({head.ny_coef[1], head.yd_coef[1],
+            head.js_clin[0], head.js_clin[1]});
+    }
+    std::sort(coefs.begin(), coefs.end());
+    return std::adjacent_find(coefs.begin(), coefs.end())
+        == coefs.end();
+}
+
+int main() {
+    iw17::test_suite suite;
+    std::vector<uint8_t> bytes = builtin_bytes();
+    const char *path = "mapped_test_data.bin";
+    const char *bad = "mapped_test_bad.bin";
+    suite.test("save_bytes", true, save_bytes, path, bytes);
+    suite.test("dataset::open", true, mapped_lunar, path);
+    suite.test("dataset::open", true, mapped_solar, path);
+    suite.test("check_layout", true, mapped_reject, bad, bytes);
+    for (int16_t era: {100, 7}) {
+        suite.test("eras_refit", true, eras_refit, era_bytes(era));
+        suite.test("save_bytes", true, save_bytes, path, era_bytes(era));
+        suite.test("dataset::segments", true, mapped_lunar, path);
+        suite.test("dataset::segments", true, mapped_solar, path);
+    }
+    suite.test("check_directory", true, eras_reject, era_bytes(60));
+    std::remove(path);
+    std::remove(bad);
+    return suite.complete();
+}
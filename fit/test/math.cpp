@@ -114,6 +114,30 @@ constexpr im::fix64 sins[N] = {
     im::fill_fix64(-0xe281'a60a_i64),
 };
 
+// bit manipulations
+
+constexpr uint64_t bits[N] = {
+    0_u64, 0x1fff_u64, 0x8000'0000'0000'0001_u64, ~0_u64,
+};
+constexpr int pops[N] = {
+    0, 13, 2, 64,
+};
+
+// table-driven against series, over 2 rounds by odd steps
+bool lut_within(im::fix64 (*lut)(im::fix64) noexcept,
+    im::fix64 (*ref)(im::fix64) noexcept, int64_t tol
+) {
+    constexpr int64_t ROUND = 4 * im::fix::SCALE;
+    for (int64_t xv = -ROUND; xv <= ROUND; xv += 4099) {
+        im::fix64 x = im::fill_fix64(xv);
+        int64_t diff = im::pour_int64(lut(x) - ref(x));
+        if (diff < -tol || diff > tol) {
+            return false;
+        }
+    }
+    return true;
+}
+
 int main() {
     iw17::test_suite suite;
     for (uint64_t i = 0; i < N; i++) {
@@ -153,6 +177,24 @@ int main() {
         suite.test("sinq", fix_close,
             sins[i], im::sinq, vals[i]
         );
+        suite.test("popcount",
+            pops[i], iw17::prestd::popcount, bits[i]
+        );
     }
+    // remainders over 2^31, as Julian centuries far from J2000
+    suite.test("fair_div", im::fill_fix64(-0x0000'0000'ffff'1a55_i64),
+        im::fair_div, -3155716800_i64, +3155760000_i64);
+    suite.test("fair_div", im::fill_fix64(+0x0000'0001'fffd'4eff_i64),
+        im::fair_div, +6311390400_i64, +3155760000_i64);
+    suite.test("fair_div", im::fill_fix64(-0x0000'0000'ffff'ffff_i64),
+        im::fair_div, +0x4000'0000'0000'0005_i64,
+        -0x4000'0000'0000'0007_i64);
+    // 4e-8, as 172 units of 2^-32
+    suite.test("_lut::sinq",
+        true, lut_within, im::_lut::sinq, im::sinq, 172_i64
+    );
+    suite.test("_lut::cosq",
+        true, lut_within, im::_lut::cosq, im::cosq, 172_i64
+    );
     return suite.complete() != 0;
 }
\ No newline at end of file
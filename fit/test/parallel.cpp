@@ -0,0 +1,214 @@
+#include <vector>
+
+#include "../parallel.hpp"
+#include "test.hpp"
+
+constexpr uint64_t N = 4;
+
+constexpr unsigned threads[N] = {
+    1, 2, 3, 8,
+};
+
+constexpr uint64_t M = 200000; // more than GRAIN per thread
+
+// usecs from NIAN_MIN to CJIE_MAX, sorted by `step` or scrambled
+std::vector<int64_t> make_usecs(int64_t step, bool scramble) {
+    using iw17::CJIE_MIN, iw17::CJIE_MAX;
+    int64_t usec_min = iw17::cjie_to_usec(CJIE_MIN + 24);
+    int64_t span = iw17::cjie_to_usec(CJIE_MAX) - usec_min;
+    std::vector<int64_t> usecs(M);
+    uint64_t seed = 20251016;
+    for (uint64_t i = 0; i < M; i++) {
+        seed = seed * 6364136223846793005 + 1442695040888963407;
+        uint64_t pick = scramble ? seed >> 11 : i * uint64_t(step);
+        usecs[i] = usec_min + int64_t(pick % uint64_t(span));
+    }
+    return usecs;
+}
+
+// parallel conversions against one-by-one ones
+bool parallel_usec_to_shihou(
+    unsigned nthr, int64_t step, bool scramble
+) {
+    iw17::parallel::pool exec(nthr);
+    std::vector<int64_t> usecs = make_usecs(step, scramble);
+    std::vector<iw17::shihou> shis(M);
+    iw17::parallel::usec_to_shihou(exec, usecs.data(), shis.data(), M);
+    for (uint64_t j = 0; j < M; j++) {
+        if (!(shis[j] == iw17::usec_to_shihou(usecs[j]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parallel_usec_to_bazi(
+    unsigned nthr, int64_t step, bool scramble
+) {
+    iw17::parallel::pool exec(nthr);
+    std::vector<int64_t> usecs = make_usecs(step, scramble);
+    std::vector<iw17::bazi> bazis(M);
+    iw17::parallel::usec_to_bazi(exec,
+        usecs.data(), bazis.data(), M, 116.4
+    );
+    for (uint64_t j = 0; j < M; j++) {
+        if (!(bazis[j] == iw17::usec_to_bazi(usecs[j], 116.4))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// hourly over the last `jie` and a day past it, `bazi{}` past it
+bool last_jie_bazi(unsigned nthr) {
+    using iw17::CJIE_MAX;
+    iw17::parallel::pool exec(nthr);
+    int64_t usec_min = iw17::cjie_to_usec(CJIE_MAX - 1);
+    int64_t usec_max = iw17::cjie_to_usec(CJIE_MAX);
+    std::vector<int64_t> usecs;
+    for (int64_t usec = usec_min; usec < usec_max + 86400; usec += 3600) {
+        usecs.push_back(usec);
+    }
+    usecs.push_back(usec_max - 1);
+    usecs.push_back(usec_max);
+    std::vector<iw17::bazi> bazis(usecs.size());
+    iw17::parallel::usec_to_bazi(exec,
+        usecs.data(), bazis.data(), usecs.size(), 116.4
+    );
+    for (uint64_t j = 0; j < usecs.size(); j++) {
+        iw17::bazi real = (usecs[j] < usec_max)
+            ? iw17::usec_to_bazi(usecs[j], 116.4) : iw17::bazi{};
+        if (!(bazis[j] == real)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parallel_usec_to_riqi(
+    unsigned nthr, int64_t step, bool scramble
+) {
+    iw17::parallel::pool exec(nthr);
+    std::vector<int64_t> usecs = make_usecs(step, scramble);
+    std::vector<iw17::riqi> rizis(M);
+    iw17::parallel::usec_to_riqi(exec, usecs.data(), rizis.data(), M);
+    for (uint64_t j = 0; j < M; j++) {
+        int32_t uday = iw17::usec_to_uday(usecs[j]);
+        if (!(rizis[j] == iw17::uday_to_riqi(uday))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parallel_uday_to_riqi(
+    unsigned nthr, int64_t step, bool scramble
+) {
+    iw17::parallel::pool exec(nthr);
+    std::vector<int64_t> usecs = make_usecs(step, scramble);
+    std::vector<int32_t> udays(M);
+    for (uint64_t j = 0; j < M; j++) {
+        udays[j] = iw17::usec_to_uday(usecs[j]);
+    }
+    std::vector<iw17::riqi> rizis(M);
+    iw17::parallel::uday_to_riqi(exec, udays.data(), rizis.data(), M);
+    for (uint64_t j = 0; j < M; j++) {
+        if (!(rizis[j] == iw17::uday_to_riqi(udays[j]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// every item exactly once, over repeated jobs on one pool
+bool pool_run_cover(unsigned nthr, uint64_t num) {
+    iw17::parallel::pool exec(nthr);
+    std::vector<uint8_t> hits(num);
+    for (int rep = 0; rep < 16; rep++) {
+        exec.run(num, [&hits](uint64_t beg, uint64_t end) noexcept {
+            for (uint64_t i = beg; i < end; i++) {
+                hits[i] += 1;
+            }
+        });
+    }
+    for (uint8_t hit: hits) {
+        if (hit != 16) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// every item exactly once, over jobs of 4 callers on one pool
+bool pool_run_shared(unsigned nthr, uint64_t num) {
+    iw17::parallel::pool exec(nthr);
+    std::vector<std::vector<uint8_t>> hits(4);
+    std::vector<std::thread> callers;
+    for (std::vector<uint8_t> &mine: hits) {
+        mine.resize(num);
+        callers.emplace_back([&exec, &mine, num] {
+            for (int rep = 0; rep < 8; rep++) {
+                exec.run(num, [&mine](uint64_t beg, uint64_t end) noexcept {
+                    for (uint64_t i = beg; i < end; i++) {
+                        mine[i] += 1;
+                    }
+                });
+            }
+        });
+    }
+    for (std::thread &caller: callers) {
+        caller.join();
+    }
+    for (const std::vector<uint8_t> &mine: hits) {
+        for (uint8_t hit: mine) {
+            if (hit != 8) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main() {
+    using namespace iw17::prestd::literal;
+    iw17::test_suite suite;
+    for (uint64_t i = 0; i < N; i++) {
+        suite.test("pool::run",
+            true, pool_run_cover, threads[i], 0_u64
+        );
+        suite.test("pool::run",
+            true, pool_run_cover, threads[i], 1000003_u64
+        );
+        suite.test("pool::run",
+            true, pool_run_shared, threads[i], 1000003_u64
+        );
+        suite.test("parallel::usec_to_shihou",
+            true, parallel_usec_to_shihou, threads[i], 3601_i64, false
+        );
+        suite.test("parallel::usec_to_shihou",
+            true, parallel_usec_to_shihou, threads[i], 0_i64, true
+        );
+        suite.test("parallel::usec_to_bazi",
+            true, parallel_usec_to_bazi, threads[i], 7207_i64, false
+        );
+        suite.test("parallel::usec_to_bazi",
+            true, parallel_usec_to_bazi, threads[i], 0_i64, true
+        );
+        suite.test("parallel::usec_to_bazi",
+            true, last_jie_bazi, threads[i]
+        );
+        suite.test("parallel::usec_to_riqi",
+            true, parallel_usec_to_riqi, threads[i], 86399_i64, false
+        );
+        suite.test("parallel::usec_to_riqi",
+            true, parallel_usec_to_riqi, threads[i], 0_i64, true
+        );
+        suite.test("parallel::uday_to_riqi",
+            true, parallel_uday_to_riqi, threads[i], 3601_i64, false
+        );
+        suite.test("parallel::uday_to_riqi",
+            true, parallel_uday_to_riqi, threads[i], 0_i64, true
+        );
+    }
+    return suite.complete();
+}
@@ -0,0 +1,109 @@
+#include <iterator>
+#include <type_traits>
+
+#include "../range.hpp"
+#include "test.hpp"
+
+using jq = iw17::jieqi;
+
+constexpr uint64_t N = 4;
+
+constexpr int16_t nians[N] = {
+    1900, 1984, 2024, 2199,
+};
+constexpr uint64_t sizes[N] = {
+    384, 384, 354, 384,
+};
+constexpr iw17::date dates[N] = {
+    iw17::date{1900,  2,  4},
+    iw17::date{1984,  6, 21},
+    iw17::date{2024, 12, 21},
+    iw17::date{2199, 12, 31},
+};
+constexpr jq jies[N] = {
+    jq::lichun, jq::xiazhi, jq::dongzhi, jq::daxue,
+};
+constexpr bool jiaos[N] = {
+    true, true, true, false,
+};
+
+// all fields of `info` against one-by-one conversions
+bool check_info(iw17::tian_info info) {
+    using namespace iw17;
+    int32_t uday = info.uday;
+    int32_t cjie = _rng::uday_to_cjie(uday);
+    bool jiao = cjie != _rng::uday_to_cjie(uday - 1);
+    return info.locd == uday_to_date(uday)
+        && info.rizi == uday_to_riqi(uday)
+        && info.zhu == uday_to_ganzhi(uday)
+        && info.jie == cjie_to_shihou(cjie).jie
+        && info.jiao == jiao;
+}
+
+bool walk_forward(int16_t fore, int16_t back) {
+    iw17::riqi_range span = {
+        iw17::nian_to_range(fore).first,
+        iw17::nian_to_range(back).last,
+    };
+    int32_t uday = span.first;
+    for (iw17::tian_info info: span) {
+        if (info.uday != uday++ || !check_info(info)) {
+            return false;
+        }
+    }
+    return uday == span.last + 1;
+}
+
+bool walk_backward(int16_t fore, int16_t back) {
+    iw17::riqi_range span = {
+        iw17::nian_to_range(fore).first,
+        iw17::nian_to_range(back).last,
+    };
+    int32_t uday = span.last;
+    for (auto it = span.end(); it != span.begin(); ) {
+        if ((--it)->uday != uday-- || !check_info(*it)) {
+            return false;
+        }
+    }
+    return uday == span.first - 1;
+}
+
+uint64_t nian_to_size(int16_t nian) {
+    return iw17::nian_to_range(nian).size();
+}
+
+jq date_to_jie(iw17::date locd) {
+    return iw17::riqi_iter(iw17::date_to_uday(locd))->jie;
+}
+
+bool date_to_jiao(iw17::date locd) {
+    return iw17::riqi_iter(iw17::date_to_uday(locd))->jiao;
+}
+
+int main() {
+    using iw17::NIAN_MIN, iw17::NIAN_MAX;
+    iw17::test_suite suite;
+    for (uint64_t i = 0; i < N; i++) {
+        suite.test("riqi_range::size",
+            sizes[i], nian_to_size, nians[i]
+        );
+        suite.test("tian_info::jie",
+            jies[i], date_to_jie, dates[i]
+        );
+        suite.test("tian_info::jiao",
+            jiaos[i], date_to_jiao, dates[i]
+        );
+    }
+    suite.test("riqi_iter::operator++",
+        true, walk_forward, NIAN_MIN, NIAN_MAX
+    );
+    suite.test("riqi_iter::operator--",
+        true, walk_backward, NIAN_MIN, NIAN_MAX
+    );
+    // prvalue `reference`, not a forward iterator
+    static_assert(std::is_same_v<
+        std::iterator_traits<iw17::riqi_iter>::iterator_category,
+        std::input_iterator_tag
+    >);
+    return suite.complete();
+}
@@ -0,0 +1,180 @@
+#include "test.hpp"
+#include "../simd.hpp"
+
+namespace is = iw17::simd;
+
+constexpr uint64_t N = 3;
+
+constexpr is::isa isas[N] = {
+    is::isa::scalar, is::isa::sse41, is::isa::avx2,
+};
+constexpr const char *names[N] = {
+    "scalar", "sse41", "avx2",
+};
+
+constexpr uint64_t NUM_NIAN = iw17::NIAN_MAX - iw17::NIAN_MIN + 1;
+constexpr uint64_t NUM_CYUE = iw17::CYUE_MAX - iw17::CYUE_MIN + 1;
+
+// all `nian`s from NIAN_MIN, with `skip` items skipped
+bool simd_nian_to_cyue(is::isa set, uint64_t skip) {
+    static int16_t nians[NUM_NIAN];
+    static int32_t cyues[NUM_NIAN];
+    for (uint64_t i = 0; i < NUM_NIAN; i++) {
+        nians[i] = iw17::NIAN_MIN + i;
+    }
+    uint64_t num = NUM_NIAN - skip;
+    is::nian_to_cyue(nians + skip, cyues + skip, num, set);
+    for (uint64_t i = skip; i < NUM_NIAN; i++) {
+        if (cyues[i] != iw17::nian_to_cyue(nians[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// all `cyue`s from CYUE_MIN, with `skip` items skipped
+bool simd_cyue_to_uday(is::isa set, uint64_t skip) {
+    static int32_t cyues[NUM_CYUE];
+    static int32_t udays[NUM_CYUE];
+    for (uint64_t i = 0; i < NUM_CYUE; i++) {
+        cyues[i] = iw17::CYUE_MIN + int32_t(i);
+    }
+    uint64_t num = NUM_CYUE - skip;
+    is::cyue_to_uday(cyues + skip, udays + skip, num, set);
+    for (uint64_t i = skip; i < NUM_CYUE; i++) {
+        if (udays[i] != iw17::cyue_to_uday(cyues[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr uint64_t NUM_CJIE = iw17::CJIE_MAX - iw17::CJIE_MIN + 1;
+
+// all `cjie`s from CJIE_MIN, with `skip` items skipped
+bool simd_cjie_to_usec(is::isa set, uint64_t skip) {
+    static int32_t cjies[NUM_CJIE];
+    static int64_t usecs[NUM_CJIE];
+    for (uint64_t i = 0; i < NUM_CJIE; i++) {
+        cjies[i] = iw17::CJIE_MIN + int32_t(i);
+    }
+    uint64_t num = NUM_CJIE - skip;
+    is::cjie_to_usec(cjies + skip, usecs + skip, num, set);
+    for (uint64_t i = skip; i < NUM_CJIE; i++) {
+        if (usecs[i] != iw17::cjie_to_usec(cjies[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// all `shihou`s of `jie`, every `sui` from SUI_MIN
+bool simd_shihou_to_usec(is::isa set, iw17::jieqi jie) {
+    constexpr uint64_t NUM_SUI = iw17::SUI_MAX - iw17::SUI_MIN + 1;
+    static iw17::shihou shis[NUM_SUI];
+    static int64_t usecs[NUM_SUI];
+    for (uint64_t i = 0; i < NUM_SUI; i++) {
+        shis[i] = iw17::shihou{int16_t(iw17::SUI_MIN + i), jie};
+    }
+    is::shihou_to_usec(shis, usecs, NUM_SUI, set);
+    for (uint64_t i = 0; i < NUM_SUI; i++) {
+        if (usecs[i] != iw17::shihou_to_usec(shis[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// `futian`s and `shujiu`s of all `sui`s from SUI_MIN + `skip`
+bool simd_sui_to_fujiu(is::isa set, uint64_t skip) {
+    constexpr uint64_t NUM_SUI = iw17::SUI_MAX - iw17::SUI_MIN + 1;
+    static iw17::futian futs[NUM_SUI];
+    static iw17::shujiu shus[NUM_SUI];
+    int16_t sui = iw17::SUI_MIN + int16_t(skip);
+    is::sui_to_futian(sui, futs + skip, NUM_SUI - skip, set);
+    is::sui_to_shujiu(sui, shus + skip, NUM_SUI - skip, set);
+    for (uint64_t i = skip; i < NUM_SUI; i++) {
+        int16_t suii = iw17::SUI_MIN + int16_t(i);
+        if (!(futs[i] == iw17::sui_to_futian(suii))
+            || !(shus[i] == iw17::sui_to_shujiu(suii))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr uint64_t NUM_UDAY = 2000001;
+
+// udays in [from, from + NUM_UDAY) to dates and back
+bool simd_uday_date(is::isa set, int32_t from) {
+    static int32_t udays[NUM_UDAY], backs[NUM_UDAY];
+    static iw17::date dates[NUM_UDAY];
+    for (uint64_t i = 0; i < NUM_UDAY; i++) {
+        udays[i] = from + int32_t(i);
+    }
+    is::uday_to_date(udays, dates, NUM_UDAY, set);
+    is::date_to_uday(dates, backs, NUM_UDAY, set);
+    for (uint64_t i = 0; i < NUM_UDAY; i++) {
+        if (!(dates[i] == iw17::uday_to_date(udays[i]))
+            || backs[i] != udays[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    using namespace iw17::prestd::literal;
+    iw17::test_suite suite;
+    std::printf("Best instruction set: %s\n", names[int(is::best_isa())]);
+    // both ends of `int16_t` years
+    constexpr int32_t UD_MIN = iw17::date_to_uday({-32768, 1, 1});
+    constexpr int32_t UD_MAX = iw17::date_to_uday({32767, 12, 31});
+    constexpr int32_t UD_END = UD_MAX + 1 - int32_t(NUM_UDAY);
+    for (uint64_t i = 0; i < N; i++) {
+        if (isas[i] > is::best_isa()) {
+            std::printf("Instruction set %s skipped\n", names[i]);
+            continue;
+        }
+        suite.test("simd::nian_to_cyue",
+            true, simd_nian_to_cyue, isas[i], 0_u64
+        );
+        suite.test("simd::nian_to_cyue",
+            true, simd_nian_to_cyue, isas[i], 3_u64
+        );
+        suite.test("simd::cyue_to_uday",
+            true, simd_cyue_to_uday, isas[i], 0_u64
+        );
+        suite.test("simd::cyue_to_uday",
+            true, simd_cyue_to_uday, isas[i], 5_u64
+        );
+        suite.test("simd::cjie_to_usec",
+            true, simd_cjie_to_usec, isas[i], 0_u64
+        );
+        suite.test("simd::cjie_to_usec",
+            true, simd_cjie_to_usec, isas[i], 7_u64
+        );
+        suite.test("simd::shihou_to_usec",
+            true, simd_shihou_to_usec, isas[i], iw17::jieqi::xiazhi
+        );
+        suite.test("simd::shihou_to_usec",
+            true, simd_shihou_to_usec, isas[i], iw17::jieqi::daxue
+        );
+        suite.test("simd::sui_to_futian",
+            true, simd_sui_to_fujiu, isas[i], 0_u64
+        );
+        suite.test("simd::sui_to_futian",
+            true, simd_sui_to_fujiu, isas[i], 9_u64
+        );
+        suite.test("simd::uday_to_date",
+            true, simd_uday_date, isas[i], -1000000_i32
+        );
+        suite.test("simd::uday_to_date",
+            true, simd_uday_date, isas[i], UD_MIN
+        );
+        suite.test("simd::uday_to_date",
+            true, simd_uday_date, isas[i], UD_END
+        );
+    }
+    return suite.complete();
+}
@@ -37,7 +37,75 @@ constexpr iw17::zodiac zods[N] = {
     zd::leo, zd::capricorn, zd::cancer, zd::sagittarius,
 };
 
+// indexed against fitted, around each boundary
+bool index_usec_to_cjie() {
+    using iw17::CJIE_MIN, iw17::CJIE_MAX;
+    for (int32_t cjie = CJIE_MIN + 1; cjie < CJIE_MAX; cjie++) {
+        int64_t usec = iw17::cjie_to_usec(cjie);
+        int64_t half = (iw17::cjie_to_usec(cjie + 1) - usec) / 2;
+        for (int64_t inst: {usec - 1, usec, usec + half}) {
+            int32_t real = cjie - (inst < usec);
+            if (iw17::_tab::usec_to_cjie(inst) != real) {
+                return false;
+            }
+            if (iw17::usec_to_cjie(inst) != real) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// `cjie`s filled from every start, `num` each, against single ones
+bool range_cjie_to_usec(int32_t num) {
+    using iw17::CJIE_MIN, iw17::CJIE_MAX;
+    int64_t uss[64] = {};
+    for (int32_t cjie = CJIE_MIN; cjie <= CJIE_MAX; cjie++) {
+        int32_t rest = CJIE_MAX + 1 - cjie;
+        int32_t cnt = (num < rest) ? num : rest;
+        iw17::batch::cjie_to_usec(cjie, uss, cnt);
+        for (int32_t j = 0; j < cnt; j++) {
+            if (uss[j] != iw17::cjie_to_usec(cjie + j)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// `jie`s starting in windows of `span` seconds, `num` at most
+bool range_jies_between(int64_t span, uint64_t num) {
+    using iw17::CJIE_MIN, iw17::CJIE_MAX;
+    int64_t us_min = iw17::cjie_to_usec(CJIE_MIN);
+    int64_t us_max = iw17::cjie_to_usec(CJIE_MAX);
+    int64_t uss[64] = {};
+    for (int64_t from = us_min - 2 * span; from < us_max + span;
+        from += 86400 * 13 + 7) {
+        int64_t to = from + span;
+        uint64_t cnt = iw17::batch::jies_between(from, to, uss, num);
+        uint64_t real = 0;
+        for (int32_t cjie = CJIE_MIN; cjie <= CJIE_MAX; cjie++) {
+            int64_t usec = iw17::cjie_to_usec(cjie);
+            if (usec >= to) {
+                break;
+            }
+            if (usec < from) {
+                continue;
+            }
+            if (real < num && uss[real] != usec) {
+                return false;
+            }
+            real += 1;
+        }
+        if (cnt != real) {
+            return false;
+        }
+    }
+    return iw17::batch::jies_between(us_max, us_max + 1, uss, num) == 1;
+}
+
 int main() {
+    using namespace iw17::prestd::literal;
     iw17::test_suite suite;
     for (uint64_t i = 0; i < N; i++) {
         suite.test("shihou_to_cjie",
@@ -77,5 +145,14 @@ int main() {
             zods[i], iw17::dati_to_zodiac, datis[i]
         );
     }
+    suite.test("_tab::usec_to_cjie", true, index_usec_to_cjie);
+    suite.test("batch::cjie_to_usec", true, range_cjie_to_usec, 1_i32);
+    suite.test("batch::cjie_to_usec", true, range_cjie_to_usec, 53_i32);
+    suite.test("batch::jies_between",
+        true, range_jies_between, 86400_i64, 64_u64
+    );
+    suite.test("batch::jies_between",
+        true, range_jies_between, 34560000_i64, 8_u64
+    );
     return suite.complete();
 }
\ No newline at end of file
@@ -24,6 +24,20 @@ IW_ENABLE_EQUAL_BY(bazi, prestd::uint_cast)
 
 IW_ENABLE_EQUAL_BY_PAIR(shihou)
 
+constexpr bool operator==(futian a, futian b) noexcept {
+    return a.toufu == b.toufu && a.erfu == b.erfu
+        && a.sanfu == b.sanfu && a.udnx == b.udnx;
+}
+
+constexpr bool operator==(shujiu a, shujiu b) noexcept {
+    for (int8_t jiu = 0; jiu <= 9; jiu++) {
+        if (a.jius[jiu] != b.jius[jiu]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace iw17
 
 #undef IW_ENABLE_EQUAL_BY_UINT
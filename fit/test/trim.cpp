@@ -0,0 +1,116 @@
+#include <cstdio>
+#include <vector>
+
+#include "../mapped.hpp"
+#include "builtin.hpp"
+#include "test.hpp"
+
+namespace data = iw17::data;
+namespace trim = iw17::trim;
+
+// bytes of tables in use, by configuration
+void size_report() {
+    uint64_t extra = 0;
+#if IW_NONGLI_DENSE
+    extra += sizeof(iw17::_tab::NY_DENSE<>) + sizeof(iw17::_tab::YD_DENSE<>)
+        + sizeof(iw17::_tab::NI_PACKS<>);
+#endif // IW_NONGLI_DENSE
+#if IW_NONGLI_UDAY_INDEX
+    extra += sizeof(iw17::_tab::UR_INDEX<>);
+#endif // IW_NONGLI_UDAY_INDEX
+#if IW_NONGLI_JIE_INDEX
+    extra += sizeof(iw17::_tab::JS_DENSE<>);
+#endif // IW_NONGLI_JIE_INDEX
+    uint64_t full = trim::table_bytes(data::NIAN_MIN, data::NIAN_MAX,
+        data::CYUE_MIN, data::CYUE_MAX);
+    std::printf("nian %d..%d: residuals %llu bytes (%llu untrimmed), "
+        "tables of backends %llu bytes\n", trim::NIAN_MIN, trim::NIAN_MAX,
+        (unsigned long long)trim::TABLE_BYTES, (unsigned long long)full,
+        (unsigned long long)extra);
+}
+
+// limits sliced out of those of `data.hpp`
+bool trim_limits(std::vector<uint8_t> bytes) {
+    using namespace iw17::trim::limits;
+    iw17::mapped::dataset full;
+    if (!full.attach(bytes.data(), bytes.size())) {
+        return false;
+    }
+    return data::NIAN_MIN <= NIAN_MIN && NIAN_MAX <= data::NIAN_MAX
+        && CYUE_MIN == full.nian_to_cyue(NIAN_MIN)
+        && CYUE_MAX == full.nian_to_cyue(NIAN_MAX + 1) - 1
+        && CJIE_MIN == 24 * (SUI_MIN - 1970)
+        && CJIE_MAX == 24 * (SUI_MAX - 1970) + 23
+        && sizeof(trim::NR_RUNS) * 2 >= uint64_t(NIAN_MAX + 1 - NIAN_MIN)
+        && sizeof(trim::NY_RESY) * 8 >= uint64_t(NIAN_MAX + 2 - NIAN_MIN);
+}
+
+// trimmed functions against full tables, over the trimmed range
+bool trim_lunar(std::vector<uint8_t> bytes) {
+    using namespace iw17::trim::limits;
+    iw17::mapped::dataset full;
+    if (!full.attach(bytes.data(), bytes.size())) {
+        return false;
+    }
+    for (int16_t nian = NIAN_MIN; nian <= NIAN_MAX + 1; nian++) {
+        if (iw17::nian_to_cyue(nian) != full.nian_to_cyue(nian)) {
+            return false;
+        }
+        if (nian <= NIAN_MAX
+            && iw17::nian_to_run(nian) != full.nian_to_run(nian)) {
+            return false;
+        }
+    }
+    for (int32_t cyue = CYUE_MIN; cyue <= CYUE_MAX + 1; cyue++) {
+        if (iw17::cyue_to_uday(cyue) != full.cyue_to_uday(cyue)) {
+            return false;
+        }
+    }
+    int32_t uday_min = full.cyue_to_uday(CYUE_MIN);
+    int32_t uday_max = full.cyue_to_uday(CYUE_MAX + 1);
+    for (int32_t uday = uday_min; uday < uday_max; uday++) {
+        iw17::riqi rizi = iw17::uday_to_riqi(uday);
+        if (!(rizi == full.uday_to_riqi(uday))
+            || iw17::riqi_to_uday(rizi) != uday) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool trim_solar(std::vector<uint8_t> bytes) {
+    using namespace iw17::trim::limits;
+    iw17::mapped::dataset full;
+    if (!full.attach(bytes.data(), bytes.size())) {
+        return false;
+    }
+    for (int32_t cjie = CJIE_MIN; cjie <= CJIE_MAX; cjie++) {
+        int64_t usec = full.cjie_to_usec(cjie);
+        if (iw17::cjie_to_usec(cjie) != usec) {
+            return false;
+        }
+        if (cjie == CJIE_MIN) {
+            continue;
+        }
+        for (int64_t inst: {usec - 1, usec, usec + 3600}) {
+            if (iw17::usec_to_cjie(inst) != full.usec_to_cjie(inst)) {
+                return false;
+            }
+            auto real = full.usec_to_bazi(inst, 116.4);
+            if (!(iw17::usec_to_bazi(inst, 116.4) == real)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main() {
+    iw17::test_suite suite;
+    std::vector<uint8_t> bytes = builtin_bytes();
+    size_report();
+    suite.test("trim::limits", true, trim_limits, bytes);
+    suite.test("trim::NY_RESY", true, trim_lunar, bytes);
+    suite.test("trim::JS_ARRS", true, trim_solar, bytes);
+    return suite.complete();
+}
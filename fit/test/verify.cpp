@@ -0,0 +1,399 @@
+// verifies every public conversion against ground truth of a fixture,
+// over all `nian`s, `cyue`s, udays and `cjie`s in range, on all cores
+//
+//   nongli_verify [--threads=N] FIXTURE
+//   nongli_verify --dump=FIXTURE
+//
+// Fixtures are written by `data/truth.py` from CSVs of `split.py`, or
+// by `--dump` from the compiled fittings, which reproduce those CSVs
+// exactly. All fields are little-endian, as in `data/truth.py`:
+//   head: "IWTR", version 1, `nian`s, first `cyue`, `cyue`s, first
+//         `cjie`, `cjie`s (32 bytes)
+//   yues: first uday, `nian` and `ryue` of each `cyue` (8 bytes each),
+//         up to the first of the `nian` after the last
+//   jies: usec of each `cjie` (8 bytes each)
+// Mismatches and throughput are reported per function; the exit code
+// is 1 if any mismatches, 2 if the fixture is unusable.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../nongli.hpp"
+#include "../parallel.hpp"
+
+namespace {
+
+using namespace iw17;
+
+constexpr char MAGIC[4] = {'I', 'W', 'T', 'R'};
+constexpr uint32_t VERSION = 1;
+
+struct truth_head {
+    char magic[4];
+    uint32_t version;
+    int16_t nian_min, nian_max;
+    int32_t cyue_min;
+    uint32_t cyues;
+    int32_t cjie_min;
+    uint32_t cjies;
+    uint32_t reserved;
+};
+
+struct truth_yue {
+    int32_t ud01;
+    int16_t nian;
+    int8_t ryue;
+    int8_t pad;
+};
+
+static_assert(sizeof(truth_head) == 32, "packed head");
+static_assert(sizeof(truth_yue) == 8, "packed yues");
+
+struct truth {
+    truth_head head;
+    std::vector<truth_yue> yues;
+    std::vector<int64_t> jies;
+
+    // record of `cyue`, within the compiled range
+    const truth_yue &yue(int32_t cyue) const noexcept {
+        return yues[cyue - head.cyue_min];
+    }
+
+    int64_t jie(int32_t cjie) const noexcept {
+        return jies[cjie - head.cjie_min];
+    }
+};
+
+// the compiled range, written by the fittings themselves
+truth dump_truth() {
+    truth tr = {};
+    std::memcpy(tr.head.magic, MAGIC, sizeof(MAGIC));
+    tr.head.version = VERSION;
+    tr.head.nian_min = NIAN_MIN, tr.head.nian_max = NIAN_MAX;
+    tr.head.cyue_min = CYUE_MIN;
+    tr.head.cyues = CYUE_MAX + 2 - CYUE_MIN;
+    tr.head.cjie_min = CJIE_MIN;
+    tr.head.cjies = CJIE_MAX + 1 - CJIE_MIN;
+    for (int16_t nian = NIAN_MIN; nian <= NIAN_MAX + 1; nian++) {
+        int32_t cy01 = _fit::nian_to_cyue(nian);
+        int32_t cynx = _fit::nian_to_cyue(nian + 1);
+        int8_t run = (nian <= NIAN_MAX) ? nian_to_run(nian) : 13;
+        for (int32_t cyue = cy01; cyue < cynx; cyue++) {
+            int32_t ud01 = _fit::cyue_to_uday(cyue);
+            int8_t ryue = nyue_to_ryue(cyue - cy01, run);
+            tr.yues.push_back(truth_yue{ud01, nian, ryue, 0});
+            if (nian > NIAN_MAX) {
+                break; // only the first of the `nian` after
+            }
+        }
+    }
+    for (int32_t cjie = CJIE_MIN; cjie <= CJIE_MAX; cjie++) {
+        tr.jies.push_back(_fit::js_pred(cjie_to_shihou(cjie))
+            + _fit::js_ress(cjie));
+    }
+    return tr;
+}
+
+bool save_truth(const char *path, const truth &tr) {
+    std::FILE *fp = std::fopen(path, "wb");
+    if (fp == nullptr) {
+        return false;
+    }
+    bool fine = std::fwrite(&tr.head, sizeof(tr.head), 1, fp) == 1
+        && std::fwrite(tr.yues.data(), sizeof(truth_yue),
+            tr.yues.size(), fp) == tr.yues.size()
+        && std::fwrite(tr.jies.data(), sizeof(int64_t),
+            tr.jies.size(), fp) == tr.jies.size();
+    return (std::fclose(fp) == 0) && fine;
+}
+
+// false if unreadable, damaged or not covering the compiled range
+bool load_truth(const char *path, truth &tr) {
+    std::FILE *fp = std::fopen(path, "rb");
+    if (fp == nullptr) {
+        return false;
+    }
+    truth_head &head = tr.head;
+    bool fine = std::fread(&head, sizeof(head), 1, fp) == 1
+        && std::memcmp(head.magic, MAGIC, sizeof(MAGIC)) == 0
+        && head.version == VERSION
+        && head.nian_min <= NIAN_MIN && NIAN_MAX <= head.nian_max
+        && head.cjie_min <= CJIE_MIN
+        && CJIE_MAX < head.cjie_min + int64_t(head.cjies)
+        && head.cyues < (1u << 20) && head.cjies < (1u << 20);
+    if (fine) {
+        tr.yues.resize(head.cyues);
+        tr.jies.resize(head.cjies);
+        fine = std::fread(tr.yues.data(), sizeof(truth_yue),
+                tr.yues.size(), fp) == tr.yues.size()
+            && std::fread(tr.jies.data(), sizeof(int64_t),
+                tr.jies.size(), fp) == tr.jies.size()
+            && std::fgetc(fp) == EOF;
+    }
+    std::fclose(fp);
+    // compiled `cyue`s, up to the first of NIAN_MAX + 1, all in
+    return fine && head.cyue_min <= CYUE_MIN
+        && CYUE_MAX + 1 < head.cyue_min + int64_t(head.cyues);
+}
+
+using clk_t = std::chrono::steady_clock;
+
+struct verifier {
+    parallel::pool &exec;
+    uint64_t fails = 0;
+
+    // `count(beg, end)` mismatches of keys `[beg, end)` of `num`, on
+    // all threads; reports the first key mismatched, from `key0`
+    template <class Count>
+    void check(const char *name, int64_t key0, uint64_t num,
+        Count count) {
+        std::atomic<uint64_t> bad{0}, first{num};
+        auto t0 = clk_t::now();
+        exec.run(num, [&](uint64_t beg, uint64_t end) noexcept {
+            uint64_t at = num;
+            uint64_t nbad = count(beg, end, at);
+            bad += nbad;
+            for (uint64_t old = first.load(); at < old
+                && !first.compare_exchange_weak(old, at); ) {}
+        });
+        auto t1 = clk_t::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0)
+            .count();
+        std::printf("%-26s %10" PRIu64 " %8" PRIu64 " %10.2f",
+            name, num, bad.load(), 1e3 * double(num) / ns);
+        if (bad.load() != 0) {
+            std::printf("  first at %" PRId64, key0 + int64_t(first));
+        }
+        std::printf("\n");
+        fails += bad.load();
+    }
+
+    // `ok(i)` on each key `i`
+    template <class Ok>
+    void each(const char *name, int64_t key0, uint64_t num, Ok ok) {
+        this->check(name, key0, num,
+            [&](uint64_t beg, uint64_t end, uint64_t &at) {
+                uint64_t nbad = 0;
+                for (uint64_t i = beg; i < end; i++) {
+                    if (!ok(key0 + int64_t(i))) {
+                        at = std::min(at, i), nbad++;
+                    }
+                }
+                return nbad;
+            });
+    }
+};
+
+bool same(riqi a, riqi b) {
+    return a.nian == b.nian && a.ryue == b.ryue && a.tian == b.tian;
+}
+
+bool same(date a, date b) {
+    return a.year == b.year && a.mon == b.mon && a.day == b.day;
+}
+
+bool same(shihou a, shihou b) {
+    return a.sui == b.sui && a.jie == b.jie;
+}
+
+void verify_lunar(verifier &ver, const truth &tr) {
+    const int32_t ud_min = tr.yue(CYUE_MIN).ud01;
+    const int32_t ud_end = tr.yue(CYUE_MAX + 1).ud01;
+    std::vector<int32_t> cy01s(NIAN_MAX + 2 - NIAN_MIN);
+    std::vector<int8_t> runs(NIAN_MAX + 1 - NIAN_MIN, 13);
+    for (int32_t cyue = CYUE_MAX + 1; cyue >= CYUE_MIN; cyue--) {
+        const truth_yue &rec = tr.yue(cyue);
+        cy01s[rec.nian - NIAN_MIN] = cyue;
+        if (rec.ryue & 1) { // never the first of NIAN_MAX + 1
+            runs[rec.nian - NIAN_MIN] = rec.ryue >> 1;
+        }
+    }
+    // `riqi` of uday, as the truth has it
+    auto truth_riqi = [&](int32_t uday) {
+        int32_t cyue = CYUE_MIN + int32_t(
+            int64_t(uday - ud_min) * 10000 / 295306);
+        cyue = std::min(cyue, CYUE_MAX);
+        while (tr.yue(cyue + 1).ud01 <= uday) {
+            cyue++;
+        }
+        while (tr.yue(cyue).ud01 > uday) {
+            cyue--;
+        }
+        auto [ud01, nian, ryue, _] = tr.yue(cyue);
+        return riqi{nian, ryue, int8_t(uday - ud01 + 1)};
+    };
+    const uint64_t nnian = NIAN_MAX + 1 - NIAN_MIN;
+    ver.each("nian_to_cyue", NIAN_MIN, nnian + 1, [&](int64_t nian) {
+        return nian_to_cyue(int16_t(nian)) == cy01s[nian - NIAN_MIN];
+    });
+    ver.each("nian_to_run", NIAN_MIN, nnian, [&](int64_t nian) {
+        return nian_to_run(int16_t(nian)) == runs[nian - NIAN_MIN];
+    });
+    const uint64_t nyue = CYUE_MAX + 1 - CYUE_MIN;
+    ver.each("cyue_to_uday", CYUE_MIN, nyue + 1, [&](int64_t cyue) {
+        return cyue_to_uday(int32_t(cyue)) == tr.yue(cyue).ud01;
+    });
+    ver.each("days_in_cyue", CYUE_MIN, nyue, [&](int64_t cyue) {
+        int32_t days = tr.yue(cyue + 1).ud01 - tr.yue(cyue).ud01;
+        return days_in_cyue(int32_t(cyue)) == days;
+    });
+    ver.each("cyue_to_nian", CYUE_MIN, nyue, [&](int64_t cyue) {
+        return cyue_to_nian(int32_t(cyue)) == tr.yue(cyue).nian;
+    });
+    ver.check("batch::cyue_to_uday", CYUE_MIN, nyue + 1,
+        [&](uint64_t beg, uint64_t end, uint64_t &at) {
+            std::vector<int32_t> udays(end - beg);
+            batch::cyue_to_uday(int32_t(CYUE_MIN + beg), udays.data(),
+                end - beg);
+            uint64_t nbad = 0;
+            for (uint64_t i = beg; i < end; i++) {
+                if (udays[i - beg] != tr.yue(CYUE_MIN + i).ud01) {
+                    at = std::min(at, i), nbad++;
+                }
+            }
+            return nbad;
+        });
+    const uint64_t nday = ud_end - ud_min;
+    ver.each("uday_to_cyue", ud_min, nday, [&](int64_t uday) {
+        int32_t cyue = uday_to_cyue(int32_t(uday));
+        return tr.yue(cyue).ud01 <= uday && uday < tr.yue(cyue + 1).ud01;
+    });
+    ver.each("uday_to_riqi", ud_min, nday, [&](int64_t uday) {
+        return same(uday_to_riqi(int32_t(uday)), truth_riqi(uday));
+    });
+    ver.each("riqi_to_uday", ud_min, nday, [&](int64_t uday) {
+        return riqi_to_uday(truth_riqi(uday)) == uday;
+    });
+    ver.each("check_riqi", ud_min, nday, [&](int64_t uday) {
+        riqi rizi = truth_riqi(uday);
+        bool last = uday + 1 == ud_end
+            || truth_riqi(uday + 1).tian == 1;
+        riqi past = {rizi.nian, rizi.ryue, int8_t(rizi.tian + 1)};
+        return check_riqi(rizi) && (!last || !check_riqi(past));
+    });
+    ver.each("date_to_riqi", ud_min, nday, [&](int64_t uday) {
+        date locd = uday_to_date(int32_t(uday));
+        return same(date_to_riqi(locd), truth_riqi(uday));
+    });
+    ver.each("riqi_to_date", ud_min, nday, [&](int64_t uday) {
+        date locd = uday_to_date(int32_t(uday));
+        return same(riqi_to_date(truth_riqi(uday)), locd);
+    });
+    ver.check("batch::uday_to_riqi", ud_min, nday,
+        [&](uint64_t beg, uint64_t end, uint64_t &at) {
+            std::vector<int32_t> udays(end - beg);
+            std::vector<riqi> rizis(end - beg);
+            for (uint64_t i = beg; i < end; i++) {
+                udays[i - beg] = ud_min + int32_t(i);
+            }
+            batch::uday_to_riqi(udays.data(), rizis.data(), end - beg);
+            uint64_t nbad = 0;
+            for (uint64_t i = beg; i < end; i++) {
+                if (!same(rizis[i - beg], truth_riqi(udays[i - beg]))) {
+                    at = std::min(at, i), nbad++;
+                }
+            }
+            return nbad;
+        });
+}
+
+void verify_solar(verifier &ver, const truth &tr) {
+    const uint64_t njie = CJIE_MAX + 1 - CJIE_MIN;
+    ver.each("cjie_to_usec", CJIE_MIN, njie, [&](int64_t cjie) {
+        return cjie_to_usec(int32_t(cjie)) == tr.jie(cjie);
+    });
+    ver.each("shihou_to_usec", CJIE_MIN, njie, [&](int64_t cjie) {
+        shihou shi = cjie_to_shihou(int32_t(cjie));
+        return shihou_to_usec(shi) == tr.jie(cjie);
+    });
+    // both sides of each boundary, the first one from inside only
+    ver.each("usec_to_cjie", CJIE_MIN, njie, [&](int64_t cjie) {
+        int64_t usec = tr.jie(cjie);
+        return usec_to_cjie(usec) == cjie && (cjie == CJIE_MIN
+            || usec_to_cjie(usec - 1) == cjie - 1);
+    });
+    ver.each("usec_to_shihou", CJIE_MIN, njie, [&](int64_t cjie) {
+        shihou real = cjie_to_shihou(int32_t(cjie));
+        return same(usec_to_shihou(tr.jie(cjie)), real);
+    });
+    ver.check("batch::cjie_to_usec", CJIE_MIN, njie,
+        [&](uint64_t beg, uint64_t end, uint64_t &at) {
+            std::vector<int64_t> usecs(end - beg);
+            batch::cjie_to_usec(int32_t(CJIE_MIN + beg), usecs.data(),
+                end - beg);
+            uint64_t nbad = 0;
+            for (uint64_t i = beg; i < end; i++) {
+                if (usecs[i - beg] != tr.jie(CJIE_MIN + i)) {
+                    at = std::min(at, i), nbad++;
+                }
+            }
+            return nbad;
+        });
+    ver.check("batch::usec_to_shihou", CJIE_MIN, njie,
+        [&](uint64_t beg, uint64_t end, uint64_t &at) {
+            std::vector<int64_t> usecs(end - beg);
+            std::vector<shihou> shis(end - beg);
+            for (uint64_t i = beg; i < end; i++) {
+                usecs[i - beg] = tr.jie(CJIE_MIN + i);
+            }
+            batch::usec_to_shihou(usecs.data(), shis.data(), end - beg);
+            uint64_t nbad = 0;
+            for (uint64_t i = beg; i < end; i++) {
+                shihou real = cjie_to_shihou(int32_t(CJIE_MIN + i));
+                if (!same(shis[i - beg], real)) {
+                    at = std::min(at, i), nbad++;
+                }
+            }
+            return nbad;
+        });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const char *path = nullptr, *dump = nullptr;
+    unsigned threads = 0;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (std::strncmp(arg, "--dump=", 7) == 0) {
+            dump = arg + 7;
+        } else if (std::strncmp(arg, "--threads=", 10) == 0) {
+            threads = unsigned(std::atoi(arg + 10));
+        } else {
+            path = arg;
+        }
+    }
+    if (dump != nullptr) {
+        if (!save_truth(dump, dump_truth())) {
+            std::fprintf(stderr, "Cannot write %s\n", dump);
+            return 2;
+        }
+        return 0;
+    }
+    truth tr;
+    if (path == nullptr || !load_truth(path, tr)) {
+        std::fprintf(stderr, "Unusable fixture %s\n",
+            path ? path : "(none)");
+        return 2;
+    }
+    parallel::pool exec(threads);
+    verifier ver = {exec};
+    std::printf("nian %d..%d on %u threads\n",
+        NIAN_MIN, NIAN_MAX, exec.size());
+    std::printf("%-26s %10s %8s %10s\n",
+        "function", "keys", "bad", "Mkeys/s");
+    verify_lunar(ver, tr);
+    verify_solar(ver, tr);
+    if (ver.fails != 0) {
+        std::fprintf(stderr, "%" PRIu64 " mismatches\n", ver.fails);
+        return 1;
+    }
+    std::printf("All keys matched\n");
+    return 0;
+}
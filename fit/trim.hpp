@@ -0,0 +1,212 @@
+#ifndef IW_TRIM_HPP
+#define IW_TRIM_HPP 20251016L
+
+#include <cstdint>
+
+#include "data.hpp"
+
+// range trimming: only `nian`s in [IW_NONGLI_NIAN_MIN,
+// IW_NONGLI_NIAN_MAX], residuals sliced from `data.hpp` by constexpr
+#if defined(IW_NONGLI_NIAN_MIN) || defined(IW_NONGLI_NIAN_MAX)
+#define IW_NONGLI_TRIM 1
+#else // IW_NONGLI_NIAN_MIN, IW_NONGLI_NIAN_MAX
+#define IW_NONGLI_TRIM 0
+#endif // IW_NONGLI_NIAN_MIN, IW_NONGLI_NIAN_MAX
+
+// tables in use, those of `data.hpp` unless trimmed
+namespace iw17::trim {
+
+using data::NY_BITS, data::NY_COEF;
+using data::YD_BITS, data::YD_COEF;
+using data::DY_BITS, data::DY_COEF;
+using data::YN_BITS, data::YN_COEF;
+using data::JS_BITS, data::JS_CLIN, data::JS_COEF;
+using data::SJ_BITS, data::SJ_COEF;
+
+#if IW_NONGLI_TRIM
+
+namespace _cut {
+
+template <uint64_t N>
+struct bytes_u8 {
+    uint8_t vals[N];
+};
+
+// item `i` of `bits` each, in pages of `page` bytes
+constexpr uint32_t item(
+    const uint8_t *const *arrs, int64_t page, uint64_t i, int bits
+) noexcept {
+    uint32_t val = 0;
+    for (int b = 0; b < bits; b++) {
+        uint64_t ibit = i * bits + b, ibyte = ibit / 8;
+        uint32_t bit = arrs[ibyte / page][ibyte % page] >> (ibit % 8);
+        val |= (bit & 1) << b;
+    }
+    return val;
+}
+
+// `count` items from item `from` on, packed again from bit 0
+template <uint64_t N>
+constexpr bytes_u8<N> slice(
+    const uint8_t *const *arrs, int64_t page,
+    uint64_t from, uint64_t count, int bits
+) noexcept {
+    bytes_u8<N> tab = {};
+    for (uint64_t i = 0; i < count; i++) {
+        uint32_t val = item(arrs, page, from + i, bits);
+        for (int b = 0; b < bits; b++) {
+            uint64_t ibit = i * bits + b;
+            tab.vals[ibit / 8] |= uint8_t(((val >> b) & 1) << (ibit % 8));
+        }
+    }
+    return tab;
+}
+
+inline constexpr const uint8_t *NR_ARRR[] = {
+    data::NR_RUNS,
+};
+
+inline constexpr const uint8_t *NY_ARRY[] = {
+    data::NY_RESY,
+};
+
+// `nian_to_cyue` over all `nian`s of `data.hpp`
+constexpr int32_t nian_to_cyue(int16_t nian) noexcept {
+    int64_t plin = NY_COEF[0] * nian + NY_COEF[1];
+    int64_t bfit = NY_COEF[2] * nian + NY_COEF[3];
+    uint64_t inian = nian - data::NIAN_MIN;
+    int64_t page = sizeof(data::NY_RESY);
+    return plin + (bfit >> NY_BITS) + item(NY_ARRY, page, inian, 1);
+}
+
+} // namespace _cut
+
+inline namespace limits {
+
+#ifdef IW_NONGLI_NIAN_MIN
+inline constexpr int16_t NIAN_MIN = IW_NONGLI_NIAN_MIN;
+#else // IW_NONGLI_NIAN_MIN
+inline constexpr int16_t NIAN_MIN = data::NIAN_MIN;
+#endif // IW_NONGLI_NIAN_MIN
+
+#ifdef IW_NONGLI_NIAN_MAX
+inline constexpr int16_t NIAN_MAX = IW_NONGLI_NIAN_MAX;
+#else // IW_NONGLI_NIAN_MAX
+inline constexpr int16_t NIAN_MAX = data::NIAN_MAX;
+#endif // IW_NONGLI_NIAN_MAX
+
+static_assert(data::NIAN_MIN <= NIAN_MIN && NIAN_MIN <= NIAN_MAX
+    && NIAN_MAX <= data::NIAN_MAX, "trimmed within `data.hpp`");
+
+// `sui`s and years trimmed along with `nian`s, as in `data.hpp`
+inline constexpr int16_t SUI_MIN = NIAN_MIN;
+inline constexpr int16_t SUI_MAX = NIAN_MAX;
+
+inline constexpr int16_t YEAR_MIN = NIAN_MIN;
+inline constexpr int16_t YEAR_MAX = NIAN_MAX;
+
+inline constexpr int32_t CYUE_MIN = _cut::nian_to_cyue(NIAN_MIN);
+inline constexpr int32_t CYUE_MAX = _cut::nian_to_cyue(NIAN_MAX + 1) - 1;
+
+inline constexpr int32_t CJIE_MIN =
+    data::CJIE_MIN + 24 * (SUI_MIN - data::SUI_MIN);
+inline constexpr int32_t CJIE_MAX =
+    data::CJIE_MAX - 24 * (data::SUI_MAX - SUI_MAX);
+
+} // namespace limits
+
+// `nian`s in [NIAN_MIN, NIAN_MAX + 1], 4 bits each, as many as given
+inline constexpr uint64_t NR_CUT_ITEMS = [] {
+    uint64_t items = 2 * sizeof(data::NR_RUNS);
+    items -= NIAN_MIN - data::NIAN_MIN;
+    uint64_t needs = NIAN_MAX + 2 - NIAN_MIN;
+    return (items < needs) ? items : needs;
+}();
+
+inline constexpr _cut::bytes_u8<(NIAN_MAX + 3 - NIAN_MIN) / 2> NR_CUT =
+    _cut::slice<(NIAN_MAX + 3 - NIAN_MIN) / 2>(
+        _cut::NR_ARRR, sizeof(data::NR_RUNS),
+        NIAN_MIN - data::NIAN_MIN, NR_CUT_ITEMS, 4);
+
+// `nian`s in [NIAN_MIN, NIAN_MAX + 1], 1 bit each
+inline constexpr _cut::bytes_u8<(NIAN_MAX + 9 - NIAN_MIN) / 8> NY_CUT =
+    _cut::slice<(NIAN_MAX + 9 - NIAN_MIN) / 8>(
+        _cut::NY_ARRY, sizeof(data::NY_RESY),
+        NIAN_MIN - data::NIAN_MIN, NIAN_MAX + 2 - NIAN_MIN, 1);
+
+// `cyue`s in [CYUE_MIN, CYUE_MAX + 1], 2 bits each
+inline constexpr _cut::bytes_u8<(CYUE_MAX + 5 - CYUE_MIN) / 4> YD_CUT =
+    _cut::slice<(CYUE_MAX + 5 - CYUE_MIN) / 4>(
+        data::YD_ARRD, data::YD_PAGE,
+        CYUE_MIN - data::CYUE_MIN, CYUE_MAX + 2 - CYUE_MIN, 2);
+
+// `cjie`s in [CJIE_MIN, CJIE_MAX + 1], 12 bits each, read in pairs,
+// as many as given; the last one ends the span of `CJIE_MAX`
+inline constexpr uint64_t JS_CUT_ITEMS = [] {
+    uint64_t items = data::CJIE_MAX + 1 - CJIE_MIN;
+    uint64_t needs = CJIE_MAX + 2 - CJIE_MIN;
+    return (items < needs) ? items : needs;
+}();
+
+inline constexpr uint64_t JS_CUT_SIZE = [] {
+    int32_t ijie = CJIE_MAX + 1 - CJIE_MIN;
+    return uint64_t(ijie + (ijie >> 1) + 2);
+}();
+
+inline constexpr _cut::bytes_u8<JS_CUT_SIZE> JS_CUT =
+    _cut::slice<JS_CUT_SIZE>(
+        data::JS_ARRS, data::JS_PAGE,
+        CJIE_MIN - data::CJIE_MIN, JS_CUT_ITEMS, 12);
+
+inline constexpr const auto &NR_RUNS = NR_CUT.vals;
+
+inline constexpr const auto &NY_RESY = NY_CUT.vals;
+
+// one page each, as large as needed
+inline constexpr int64_t YD_PAGE = sizeof(YD_CUT.vals);
+
+inline constexpr const uint8_t *YD_ARRD[] = {
+    YD_CUT.vals,
+};
+
+inline constexpr int64_t JS_PAGE = sizeof(JS_CUT.vals);
+
+inline constexpr const uint8_t *JS_ARRS[] = {
+    JS_CUT.vals,
+};
+
+#else // IW_NONGLI_TRIM
+
+inline namespace limits {
+
+using data::NIAN_MIN, data::NIAN_MAX;
+using data::SUI_MIN, data::SUI_MAX;
+using data::YEAR_MIN, data::YEAR_MAX;
+using data::CYUE_MIN, data::CYUE_MAX;
+using data::CJIE_MIN, data::CJIE_MAX;
+
+} // namespace limits
+
+using data::NR_RUNS, data::NY_RESY;
+using data::YD_PAGE, data::YD_ARRD;
+using data::JS_PAGE, data::JS_ARRS;
+
+#endif // IW_NONGLI_TRIM
+
+// bytes of residual tables read over a range, as a size report
+constexpr uint64_t table_bytes(
+    int16_t nian_min, int16_t nian_max, int32_t cyue_min, int32_t cyue_max
+) noexcept {
+    uint64_t nr_size = (nian_max + 3 - nian_min) / 2;
+    uint64_t ny_size = (nian_max + 9 - nian_min) / 8;
+    uint64_t yd_size = (cyue_max + 5 - cyue_min) / 4;
+    uint64_t ijie = 24 * (nian_max + 1 - nian_min) - 1;
+    return nr_size + ny_size + yd_size + ijie + (ijie >> 1) + 2;
+}
+
+inline constexpr uint64_t TABLE_BYTES =
+    table_bytes(NIAN_MIN, NIAN_MAX, CYUE_MIN, CYUE_MAX);
+
+} // namespace iw17::trim
+
+#endif // IW_TRIM_HPP